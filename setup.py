@@ -22,9 +22,8 @@ class get_pybind_include(object):
 
     
 def get_jpp_include():
-    jpp_dir = os.getenv("JPP_DIR")
-    if jpp_dir:
-        return os.path.join(jpp_dir, "software")
+    """The Jpp headers bundled in src/jpp are extended for jppy (see src/jpp/README.md),
+    so that they are used irrespective of the environment variable JPP_DIR."""
     return "src/jpp"
 
 
@@ -62,11 +61,11 @@ class BuildExt(build_ext):
     """A custom build extension for adding compiler-specific options."""
     c_opts = {
         'msvc': ['/EHsc'],
-        'unix': [],
+        'unix': ['-pthread'],
     }
     l_opts = {
         'msvc': [],
-        'unix': [],
+        'unix': ['-pthread'],
     }
 
     if sys.platform == 'darwin':
@@ -74,6 +73,9 @@ class BuildExt(build_ext):
         c_opts['unix'] += darwin_opts
         l_opts['unix'] += darwin_opts
 
+    if sys.platform.startswith('linux'):
+        l_opts['unix'] += ['-lrt']
+
     def build_extensions(self):
         ct = self.compiler.compiler_type
         opts = self.c_opts.get(ct, [])
@@ -84,6 +86,9 @@ class BuildExt(build_ext):
             opts.append(cpp_flag(self.compiler))
             if has_flag(self.compiler, '-fvisibility=hidden'):
                 opts.append('-fvisibility=hidden')
+            # identical results of compacted, memory-mapped and original tables
+            if has_flag(self.compiler, '-ffp-contract=off'):
+                opts.append('-ffp-contract=off')
         elif ct == 'msvc':
             opts.append('/DVERSION_INFO=\\"%s\\"' %
                         self.distribution.get_version())
@@ -105,7 +110,7 @@ if __name__ == '__main__':
                     get_pybind_include(user=True),
                     get_jpp_include()
                 ],
-                language='c++') for module in ['constants', 'geane', 'pdf', 'npe', 'oscprob', 'lang']
+                language='c++') for module in ['constants', 'geane', 'pdf', 'npe', 'oscprob', 'lang', 'tools']
         ],
         cmdclass = dict(
             build_ext = BuildExt
@@ -67,12 +67,13 @@ namespace JLANG {
      * Get output stream for conversion of exception.
      *
      * Note that the ostream is emptied before use.
+     * There is one ostream per thread.
      * 
      * \return           ostream
      */
     static inline std::ostream& getOstream()
     {
-      static std::ostringstream buffer;
+      static thread_local std::ostringstream buffer;
 
       buffer.str("");
 
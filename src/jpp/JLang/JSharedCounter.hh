@@ -2,6 +2,7 @@
 #define __JLANG__JSHAREDCOUNTER__
 
 #include <cstdlib>
+#include <atomic>
 
 /**
  * \author mdejong
@@ -15,6 +16,8 @@ namespace JLANG {
 
   /**
    * Shared counter.
+   *
+   * The counter is updated atomically, so that copies of a shared object can be made and destroyed concurrently.
    */
   class JSharedCounter 
   {
@@ -34,7 +37,7 @@ namespace JLANG {
     {
       detach();
 
-      counter = new int(1);
+      counter = new std::atomic<int>(1);
     }
 
 
@@ -87,11 +90,11 @@ namespace JLANG {
      */
     const int getCount()
     {
-      return (counter != NULL ? *counter : 0);
+      return (counter != NULL ? counter->load() : 0);
     }
 
   protected:
-    int* counter;
+    std::atomic<int>* counter;
   };
 }
 
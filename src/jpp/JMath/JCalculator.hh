@@ -31,15 +31,17 @@ namespace JMATH {
       return *this;
     }
 
-    static JCalculator calculator;   // calculator
+    static thread_local JCalculator calculator;   // calculator
   };
 
   
   /**
    * Calculator.
+   *
+   * There is one calculator per thread.
    */
   template<class T, int N>
-  JCalculator<T,N> JCalculator<T,N>::calculator;
+  thread_local JCalculator<T,N> JCalculator<T,N>::calculator;
   
   
   /** 
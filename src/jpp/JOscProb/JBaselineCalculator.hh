@@ -1,6 +1,12 @@
 #ifndef __JOSCPROB__JBASELINECALCULATOR__
 #define __JOSCPROB__JBASELINECALCULATOR__
 
+#include <cmath>
+#include <istream>
+#include <ostream>
+
+#include "JLang/JManip.hh"
+
 #include "JIO/JSerialisable.hh"
 
 
@@ -31,7 +37,9 @@ namespace JOSCPROB {
     JBaselineCalculator() :
       Lmin(0.0),
       Lmax(0.0)
-    {}
+    {
+      configure();
+    }
 
 
     /**
@@ -44,7 +52,9 @@ namespace JOSCPROB {
 			const double Lmax) :
       Lmin(Lmin),
       Lmax(Lmax)
-    {}
+    {
+      configure();
+    }
 
 
     /**
@@ -76,7 +86,7 @@ namespace JOSCPROB {
      */
     double getInnerRadius() const
     {
-      return 0.5 * (Lmax - Lmin);
+      return r;
     }
 
 
@@ -87,7 +97,7 @@ namespace JOSCPROB {
      */
     double getOuterRadius() const
     {
-      return 0.5 * (Lmax + Lmin);;
+      return R;
     }
     
 
@@ -99,9 +109,6 @@ namespace JOSCPROB {
      */
     double getCosth(const double L) const
     {
-      static const double r = getInnerRadius();
-      static const double R = getOuterRadius();
-      
       return (R*R - r*r - L*L) / (2*L*r);
     }
 
@@ -114,15 +121,29 @@ namespace JOSCPROB {
      */
     double getBaseline(const double costh) const
     {
-      static const double r = getInnerRadius();
-      static const double R = getOuterRadius();
-
       const double ct = (fabs(costh) < 1.0 ? costh : (costh < 0 ? -1.0 : 1.0));
     
       return (-r * ct + sqrt(R*R - r*r * (1 - ct) * (1 + ct)));
     }
 
 
+    /**
+     * Get baselines for given cosine zenith angles.
+     *
+     * \param  n               number of cosine zenith angles
+     * \param  costh           pointer to cosine zenith angles
+     * \param  L               pointer to baselines [km]
+     */
+    void getBaseline(const size_t  n,
+		     const double* costh,
+		     double*       L) const
+    {
+      for (size_t i = 0; i != n; ++i) {
+	L[i] = getBaseline(costh[i]);
+      }
+    }
+
+
     /**
      * Get baseline for a given cosine zenith angle.
      *
@@ -143,7 +164,11 @@ namespace JOSCPROB {
      */
     JReader& read(JReader& in) override
     {
-      return in >> Lmin >> Lmax;
+      in >> Lmin >> Lmax;
+
+      configure();
+
+      return in;
     }
 
     
@@ -168,7 +193,11 @@ namespace JOSCPROB {
      */
     friend inline std::istream& operator>>(std::istream& in, JBaselineCalculator& object)
     {
-      return in >> object.Lmin >> object.Lmax;
+      in >> object.Lmin >> object.Lmax;
+
+      object.configure();
+
+      return in;
     }
 
 
@@ -186,9 +215,22 @@ namespace JOSCPROB {
 
     
   protected:
+    /**
+     * Compute inner and outer radius from baseline extrema.
+     */
+    void configure()
+    {
+      r = 0.5 * (Lmax - Lmin);
+      R = 0.5 * (Lmax + Lmin);
+    }
+
     
     double Lmin; //!< Minimum baseline [km]
     double Lmax; //!< Maximum baseline [km]
+
+  private:
+    double r;    //!< Inner radius [km]
+    double R;    //!< Outer radius [km]
   };
 }
 
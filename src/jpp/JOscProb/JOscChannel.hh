@@ -4,6 +4,7 @@
 #include <iostream>
 
 #include "JLang/JComparable.hh"
+#include "JLang/JException.hh"
 
 #include "Jeep/JProperties.hh"
 
@@ -323,6 +324,155 @@ namespace JOSCPROB {
    * Number of neutrino oscillation channels.
    */
   static const unsigned int NUMBER_OF_OSCCHANNELS = sizeof(getOscChannel) / sizeof(JOscChannel);
+
+
+  /**
+   * Auxiliary data structure for the index of an oscillation channel in JOSCPROB::getOscChannel.
+   *
+   * The index is computed directly from the flavours and the charge-parity.
+   * The corresponding order of the oscillation channels in JOSCPROB::getOscChannel is verified once.
+   */
+  struct JOscChannelIndex {
+    /**
+     * Get index of oscillation channel.
+     *
+     * \param  in                  incoming  flavour
+     * \param  out                 outcoming flavour
+     * \param  Cparity             charge-parity
+     * \return                     index; -1 if undefined
+     */
+    static inline int getIndex(const JFlavour_t      in,
+			       const JFlavour_t      out,
+			       const JChargeParity_t Cparity)
+    {
+      using namespace JPP;
+
+      static const bool ordered = isOrdered();
+
+      const int i = getIndex(in);
+      const int j = getIndex(out);
+      const int k = getIndex(Cparity);
+
+      if (i == -1 || j == -1 || k == -1) {
+	return -1;
+      }
+
+      if (!ordered) {
+	THROW(JException, "Order of oscillation channels differs from index computation.");
+      }
+
+      return 9 * k + 3 * i + j;
+    }
+
+  private:
+    /**
+     * Get index of flavour.
+     *
+     * \param  flavour             flavour
+     * \return                     index; -1 if undefined
+     */
+    static inline int getIndex(const JFlavour_t flavour)
+    {
+      using namespace JPP;
+
+      switch (flavour) {
+
+      case JFlavour_t::ELECTRON:          return  0;
+      case JFlavour_t::MUON:              return  1;
+      case JFlavour_t::TAU:               return  2;
+      case JFlavour_t::FLAVOUR_UNDEFINED: return -1;
+
+      default:
+	THROW(JValueOutOfRange, "Invalid flavour " << (int) flavour);
+      }
+    }
+
+
+    /**
+     * Get index of charge-parity.
+     *
+     * \param  Cparity             charge-parity
+     * \return                     index; -1 if undefined
+     */
+    static inline int getIndex(const JChargeParity_t Cparity)
+    {
+      using namespace JPP;
+
+      switch (Cparity) {
+
+      case JChargeParity_t::PARTICLE:          return  0;
+      case JChargeParity_t::ANTIPARTICLE:      return  1;
+      case JChargeParity_t::CPARITY_UNDEFINED: return -1;
+
+      default:
+	THROW(JValueOutOfRange, "Invalid charge-parity " << (int) Cparity);
+      }
+    }
+
+
+    /**
+     * Check that the index computation follows the order of the oscillation channels in JOSCPROB::getOscChannel.
+     *
+     * \return                     true if ordered; else false
+     */
+    static inline bool isOrdered()
+    {
+      for (unsigned int index = 0; index != NUMBER_OF_OSCCHANNELS; ++index) {
+
+	const JOscChannel& channel = getOscChannel[index];
+
+	if (9 * getIndex(channel.Cparity) + 3 * getIndex(channel.in) + getIndex(channel.out) != (int) index) {
+	  return false;
+	}
+      }
+
+      return true;
+    }
+  };
+
+
+  /**
+   * Get index of oscillation channel in JOSCPROB::getOscChannel.
+   *
+   * \param  in                  incoming  flavour
+   * \param  out                 outcoming flavour
+   * \param  Cparity             charge-parity
+   * \return                     index; -1 if undefined
+   */
+  inline int getOscChannelIndex(const JFlavour_t      in,
+				const JFlavour_t      out,
+				const JChargeParity_t Cparity)
+  {
+    return JOscChannelIndex::getIndex(in, out, Cparity);
+  }
+
+
+  /**
+   * Get index of oscillation channel in JOSCPROB::getOscChannel.
+   *
+   * \param  channel             oscillation channel
+   * \return                     index; -1 if invalid
+   */
+  inline int getOscChannelIndex(const JOscChannel& channel)
+  {
+    return getOscChannelIndex(channel.in, channel.out, channel.Cparity);
+  }
+
+
+  /**
+   * Get index of oscillation channel in JOSCPROB::getOscChannel.
+   *
+   * \param  in                  PDG identifier of incoming  neutrino
+   * \param  out                 PDG identifier of outcoming neutrino
+   * \param  Cparity             charge-parity (or PDG identifier)
+   * \return                     index; -1 if invalid
+   */
+  inline int getOscChannelIndex(const int in,
+				const int out,
+				const int Cparity)
+  {
+    return getOscChannelIndex(getFlavour(in), getFlavour(out), getChargeParity(Cparity));
+  }
 }
 
 #endif
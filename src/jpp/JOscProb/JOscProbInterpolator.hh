@@ -1,6 +1,8 @@
 #ifndef __JOSCPROB__JOSCPROBINTERPOLATOR__
 #define __JOSCPROB__JOSCPROBINTERPOLATOR__
 
+#include <type_traits>
+
 #include "Jeep/JMessage.hh"
 #include "Jeep/JProperties.hh"
 
@@ -10,6 +12,7 @@
 #include "JLang/JClonable.hh"
 #include "JLang/JObjectIO.hh"
 #include "JLang/JException.hh"
+#include "JLang/JBool.hh"
 
 #include "JTools/JPolint.hh"
 #include "JTools/JMapList.hh"
@@ -67,6 +70,7 @@ namespace JOSCPROB {
     typedef JMultiFunction<JFunction1D_t, JFunctionalMaplist_t>                                    multifunction_type;
 
     enum { NUMBER_OF_DIMENSIONS = multifunction_type::NUMBER_OF_DIMENSIONS };
+    enum { NUMBER_OF_PARAMETERS = NUMBER_OF_DIMENSIONS - 2 };
 
     typedef typename multifunction_type::abscissa_type                                                  abscissa_type;    
     typedef typename multifunction_type::argument_type                                                  argument_type;
@@ -79,6 +83,9 @@ namespace JOSCPROB {
     typedef typename multifunction_type::super_iterator                                                super_iterator;
     typedef typename multifunction_type::function_type                                                  function_type;
 
+    typedef JMultiFunction<JFunction1D_t, typename JFunctionalMaplist_t::tail_type>                        slice_type;
+    typedef JTOOLS::JArray<NUMBER_OF_PARAMETERS, result_type>                                           gradient_type;
+
     using JMessage<interpolator_type>::debug;
 
     
@@ -88,7 +95,8 @@ namespace JOSCPROB {
     JOscProbInterpolator() :
       multifunction_type(),
       parameters(),
-      getBaseline()
+      getBaseline(),
+      frozen(false)
     {
       this->set(JOscParameters(false)); // Initialize buffer with NuFIT NO best fit parameters
     }
@@ -102,7 +110,8 @@ namespace JOSCPROB {
     JOscProbInterpolator(const char* fileName) :
       multifunction_type(),
       parameters(),
-      getBaseline()
+      getBaseline(),
+      frozen(false)
     {
       this->load(fileName);
       this->set(JOscParameters(false)); // Initialize buffer with NuFIT NO best fit parameters      
@@ -119,7 +128,8 @@ namespace JOSCPROB {
 			 const JOscParameters& parameters) :
       multifunction_type(),
       parameters(),
-      getBaseline()
+      getBaseline(),
+      frozen(false)
     {
       this->load(fileName);
       this->set(parameters);
@@ -202,6 +212,136 @@ namespace JOSCPROB {
 		"No value for parameter "                          << i->first);
 	}
       }
+
+      configure();
+    }
+
+
+    /**
+     * Set oscillation parameters for interpolation.
+     *
+     * This method is a fast alternative to method set(JOscParameters) which does not create any intermediate objects.\n
+     * The values should be ordered as <tt>dM21sq</tt>, <tt>dM31sq</tt>, <tt>deltaCP</tt>, <tt>sinsqTh12</tt>, <tt>sinsqTh13</tt> and <tt>sinsqTh23</tt>.
+     * The fixed oscillation parameters of this interpolation table take precedence over the given values.
+     *
+     * \param  values             oscillation parameter values
+     */
+    void set(const double* values)
+    {
+      getParameterValues(values, this->buffer.data());
+
+      configure();
+    }
+
+
+    /**
+     * Set option to freeze the oscillation parameters.
+     *
+     * If set, the interpolation table is interpolated at the current oscillation parameters
+     * for all nodes in L/E and cosine zenith angle each time the oscillation parameters are set.\n
+     * The resulting two-dimensional table is then used for the evaluation of the oscillation probabilities.
+     * This requires that all oscillation parameter values share the same nodes in L/E and cosine zenith angle;
+     * otherwise, the complete interpolation table is used.
+     * The oscillation probabilities agree with those of the complete interpolation table up to rounding errors.\n
+     * The nodes are determined when the interpolation table is read and when this option is set,
+     * so that setting the oscillation parameters only updates the values of the two-dimensional table.
+     *
+     * \param  option             option
+     */
+    void freeze(const bool option = true)
+    {
+      frozen = option;
+
+      configureLayout();
+      configure();
+    }
+
+
+    /**
+     * Check whether oscillation parameters are frozen.
+     *
+     * \return                    true if frozen; else false
+     */
+    bool is_frozen() const
+    {
+      return frozen;
+    }
+
+
+    /**
+     * Get oscillation probabilities for all oscillation channels.
+     *
+     * The oscillation probabilities are ordered according to JOSCPROB::getOscChannel.
+     *
+     * \param  E                  neutrino energy [GeV]
+     * \param  costh              cosine zenith angle
+     * \return                    oscillation probabilities
+     */
+    result_type getProbabilities(const double E,
+				 const double costh) const
+    {
+      const double L = getBaseline(costh);
+
+      if (!slice.empty()) {
+	return slice(L/E, costh);
+      }
+
+      JTOOLS::JArray<NUMBER_OF_DIMENSIONS, argument_type> point(buffer);
+
+      point[NUMBER_OF_DIMENSIONS-2] = L/E;
+      point[NUMBER_OF_DIMENSIONS-1] = costh;
+
+      const argument_type* arguments = point.data();
+
+      return this->evaluate(arguments);
+    }
+
+
+    /**
+     * Get oscillation probabilities for all oscillation channels\n
+     * for a given set of oscillation parameters.
+     *
+     * \param  parameters         oscillation parameters
+     * \param  E                  neutrino energy [GeV]
+     * \param  costh              cosine zenith angle
+     * \return                    oscillation probabilities
+     */
+    result_type getProbabilities(const JOscParameters& parameters,
+				 const double          E,
+				 const double          costh)
+    {
+      set(parameters);
+
+      return getProbabilities(E, costh);
+    }
+
+
+    /**
+     * Get oscillation probabilities and their derivatives with respect to the oscillation parameters
+     * for all oscillation channels.
+     *
+     * The derivatives are ordered as <tt>dM21sq</tt>, <tt>dM31sq</tt>, <tt>deltaCP</tt>, <tt>sinsqTh12</tt>, <tt>sinsqTh13</tt> and <tt>sinsqTh23</tt>.\n
+     * They correspond to the exact derivatives of the linear interpolation between the nodes of the oscillation parameters.
+     * At a node, the derivative of the interval below the node is taken.
+     * The derivatives with respect to the fixed oscillation parameters of this interpolation table are zero.
+     *
+     * \param  E                  neutrino energy [GeV]
+     * \param  costh              cosine zenith angle
+     * \param  gradient           derivatives of oscillation probabilities
+     * \return                    oscillation probabilities
+     */
+    result_type getProbabilities(const double   E,
+				 const double   costh,
+				 gradient_type& gradient) const
+    {
+      const double L = getBaseline(costh);
+
+      JTOOLS::JArray<NUMBER_OF_DIMENSIONS, argument_type> point(buffer);
+
+      point[NUMBER_OF_DIMENSIONS-2] = L/E;
+      point[NUMBER_OF_DIMENSIONS-1] = costh;
+
+      return getProbabilities(point.data(), gradient);
     }
 
 
@@ -220,19 +360,11 @@ namespace JOSCPROB {
       using namespace std;
       using namespace JPP;
 
-      const JOscChannel* p = find(getOscChannel, getOscChannel + NUMBER_OF_OSCCHANNELS, channel);
-	
-      if (p != end(getOscChannel)) {
+      const int index = getOscChannelIndex(channel);
 	
-	const double L = getBaseline(costh);
-
-	this->buffer[NUMBER_OF_DIMENSIONS-2] = L/E;
-	this->buffer[NUMBER_OF_DIMENSIONS-1] = costh;
-
-	const argument_type* arguments = this->buffer.data();
+      if (index != -1) {
 	
-	const size_t       index         = distance(getOscChannel, p);
-	const result_type& probabilities = this->evaluate(arguments);
+	const result_type  probabilities = getProbabilities(E, costh);
 
 	return probabilities[index];
 	
@@ -278,6 +410,9 @@ namespace JOSCPROB {
       in >> static_cast<multifunction_type&>(*this);
       
       this->compile();
+
+      configureLayout();
+      configure();
       
       return in;
     }
@@ -300,10 +435,403 @@ namespace JOSCPROB {
     }
 
     
+  protected:
+    /**
+     * Get oscillation parameter values for interpolation.
+     *
+     * The fixed oscillation parameters of this interpolation table take precedence over the given values.
+     *
+     * \param  values             oscillation parameter values
+     * \param  out                oscillation parameter values for interpolation
+     */
+    void getParameterValues(const double* values, argument_type* out) const
+    {
+      const JOscParameters::JParameter_t* const fixed[] = { &parameters.dM21sq,
+							     &parameters.dM31sq,
+							     &parameters.deltaCP,
+							     &parameters.sinsqTh12,
+							     &parameters.sinsqTh13,
+							     &parameters.sinsqTh23 };
+
+      for (size_t i = 0; i != sizeof(fixed) / sizeof(fixed[0]); ++i) {
+	out[i] = (fixed[i]->isDefined() ? fixed[i]->getValue() : values[i]);
+      }
+    }
+
+
+    /**
+     * Get oscillation probabilities and their derivatives with respect to the oscillation parameters.
+     *
+     * \param  point              oscillation parameter values, L/E and cosine zenith angle
+     * \param  gradient           derivatives of oscillation probabilities
+     * \return                    oscillation probabilities
+     */
+    result_type getProbabilities(const argument_type* point, gradient_type& gradient) const
+    {
+      result_type probabilities;
+
+      getGradient(static_cast<const multimap_type&>(*this), point, probabilities, gradient.data());
+
+      const JOscParameters::JParameter_t* const fixed[] = { &parameters.dM21sq,
+							     &parameters.dM31sq,
+							     &parameters.deltaCP,
+							     &parameters.sinsqTh12,
+							     &parameters.sinsqTh13,
+							     &parameters.sinsqTh23 };
+
+      for (int i = 0; i != NUMBER_OF_PARAMETERS; ++i) {
+	if (fixed[i]->isDefined()) {
+	  gradient[i] = result_type();
+	}
+      }
+
+      return probabilities;
+    }
+
+
+    /**
+     * Get nodes in L/E and cosine zenith angle common to all oscillation parameter values.
+     *
+     * The returned table is empty if the nodes differ between oscillation parameter values.
+     *
+     * \return                    two-dimensional table
+     */
+    const slice_type& getLayout() const
+    {
+      return layout;
+    }
+
+
+    /**
+     * Get two-dimensional table in L/E and cosine zenith angle at given oscillation parameters.
+     *
+     * The nodes of the given table should correspond to those of method getLayout;
+     * only the values of the given table are updated.
+     *
+     * \param  values             oscillation parameter values for interpolation
+     * \param  slice              two-dimensional table
+     * \return                    true if configured; else false
+     */
+    bool getSlice(const argument_type* values, slice_type& slice) const
+    {
+      using namespace std;
+      using namespace JPP;
+
+      if (slice.empty()) {
+	return false;
+      }
+
+      // interpolation at given oscillation parameters
+
+      JArray<NUMBER_OF_DIMENSIONS, argument_type> point(buffer);
+
+      copy_n(values, NUMBER_OF_DIMENSIONS - 2, point.data());
+
+      try {
+
+	for (typename slice_type::iterator i = slice.begin(); i != slice.end(); ++i) {
+
+	  point[NUMBER_OF_DIMENSIONS-2] = i->getX();
+
+	  for (typename function_type::iterator j = i->getY().begin(); j != i->getY().end(); ++j) {
+
+	    point[NUMBER_OF_DIMENSIONS-1] = j->getX();
+
+	    j->getY() = this->evaluate(point.data());
+	  }
+	}
+      }
+      catch(const JException& error) {
+	return false;
+      }
+
+      slice.compile();
+
+      return true;
+    }
+
   private:
+    /**
+     * Recursive evaluation of function values and derivatives with respect to the oscillation parameters.
+     *
+     * The oscillation parameter values are linearly interpolated,
+     * which is verified at compile time.
+     *
+     * \param  map                multidimensional map
+     * \param  pX                 pointer to abscissa values
+     * \param  value              function value
+     * \param  gradient           pointer to derivatives
+     */
+    template<class JMultiMap_t>
+    static void getGradient(const JMultiMap_t&   map,
+			    const argument_type* pX,
+			    result_type&         value,
+			    result_type*         gradient)
+    {
+      static_assert(decltype(isLinear(&map))::value,
+		    "JOscProbInterpolator<...>::getGradient(): derivatives require linear interpolation of the oscillation parameters.");
+
+      getGradient(map, pX, value, gradient, JLANG::JBool<(JMultiMap_t::NUMBER_OF_DIMENSIONS > 2)>());
+    }
+
+
+    /**
+     * Evaluation of function value and derivatives for map of oscillation parameter values other than the last.
+     *
+     * \param  map                multidimensional map
+     * \param  pX                 pointer to abscissa values
+     * \param  value              function value
+     * \param  gradient           pointer to derivatives
+     * \param  option             true
+     */
+    template<class JMultiMap_t>
+    static void getGradient(const JMultiMap_t&   map,
+			    const argument_type* pX,
+			    result_type&         value,
+			    result_type*         gradient,
+			    JLANG::JBool<true>   option)
+    {
+      typedef typename JMultiMap_t::const_iterator                               const_iterator;
+
+      static const int N = JMultiMap_t::NUMBER_OF_DIMENSIONS - 1;    // number of remaining oscillation parameters
+
+      const_iterator p;
+      const_iterator q;
+
+      const double dx = getNodes(map, *pX, p, q);
+
+      if (p != q) {
+
+	const double a  = map.getDistance(*pX, q->getX()) / dx;
+	const double b  = 1.0 - a;
+
+	result_type ya;
+	result_type yb;
+	result_type gb[N - 1];
+
+	getGradient(p->getY(), pX + 1, ya, gradient + 1);
+	getGradient(q->getY(), pX + 1, yb, gb);
+
+	gradient[0]  = yb;
+	gradient[0] -= ya;
+	gradient[0] /= dx;
+
+	for (int i = 1; i != N; ++i) {
+
+	  gb[i-1]     *= b;
+	  gradient[i] *= a;
+	  gradient[i] += gb[i-1];
+	}
+
+	ya *= a;
+	yb *= b;
+
+	value  = ya;
+	value += yb;
+
+      } else {
+
+	getGradient(p->getY(), pX + 1, value, gradient + 1);
+
+	gradient[0] = result_type();
+      }
+    }
+
+
+    /**
+     * Evaluation of function value and derivative for map of last oscillation parameter values.
+     *
+     * \param  map                multidimensional map
+     * \param  pX                 pointer to abscissa values
+     * \param  value              function value
+     * \param  gradient           pointer to derivative
+     * \param  option             false
+     */
+    template<class JMultiMap_t>
+    static void getGradient(const JMultiMap_t&   map,
+			    const argument_type* pX,
+			    result_type&         value,
+			    result_type*         gradient,
+			    JLANG::JBool<false>  option)
+    {
+      typedef typename JMultiMap_t::const_iterator                               const_iterator;
+
+      const_iterator p;
+      const_iterator q;
+
+      const double dx = getNodes(map, *pX, p, q);
+
+      if (p != q) {
+
+	const double a  = map.getDistance(*pX, q->getX()) / dx;
+	const double b  = 1.0 - a;
+
+	result_type ya = p->getY().evaluate(pX + 1);
+	result_type yb = q->getY().evaluate(pX + 1);
+
+	gradient[0]  = yb;
+	gradient[0] -= ya;
+	gradient[0] /= dx;
+
+	ya *= a;
+	yb *= b;
+
+	value  = ya;
+	value += yb;
+
+      } else {
+
+	value = p->getY().evaluate(pX + 1);
+
+	gradient[0] = result_type();
+      }
+    }
+
+
+    /**
+     * Get nodes for linear interpolation of given abscissa value.
+     *
+     * \param  map                map
+     * \param  x                  abscissa value
+     * \param  p                  lower node
+     * \param  q                  upper node; equal to lower node if map has single node
+     * \return                    distance between nodes
+     */
+    template<class JMultiMap_t>
+    static double getNodes(const JMultiMap_t&                      map,
+			   const argument_type                     x,
+			   typename JMultiMap_t::const_iterator&   p,
+			   typename JMultiMap_t::const_iterator&   q)
+    {
+      using namespace JPP;
+
+      typedef typename JMultiMap_t::distance_type                                distance_type;
+
+      if (map.size() > 1u) {
+
+	p = map.lower_bound(x);
+
+	if ((p == map.begin() && map.getDistance(x, (p++)->getX()) > distance_type::precision) ||
+	    (p == map.end()   && map.getDistance((--p)->getX(), x) > distance_type::precision)) {
+
+	  THROW(JValueOutOfRange, "JOscProbInterpolator<...>::getGradient(): abscissa out of range "
+		<< x << " <> " << map.begin()->getX() << ' ' << map.rbegin()->getX());
+	}
+
+	q = p--;
+
+	return map.getDistance(p->getX(), q->getX());
+
+      } else if (map.size() == 1u && map.getDistance(x, map.begin()->getX()) <= distance_type::precision) {
+
+	p = q = map.begin();
+
+	return 0.0;
+
+      } else {
+
+	THROW(JFunctionalException, "JOscProbInterpolator<...>::getGradient(): not enough data " << x);
+      }
+    }
+
+
+    /**
+     * Check linear interpolation of map.
+     *
+     * \param  map                pointer to map
+     * \return                    true if linear interpolation; else false
+     */
+    template<class JElement_t, template<class, class> class JMapCollection_t, class JResult_t, class JDistance_t>
+    static std::true_type  isLinear(const JTOOLS::JPolintFunction<1, JElement_t, JMapCollection_t, JResult_t, JDistance_t>* map);
+
+
+    /**
+     * Check linear interpolation of map.
+     *
+     * \return                    false
+     */
+    static std::false_type isLinear(...);
+
+
+    /**
+     * Configure nodes in L/E and cosine zenith angle common to all oscillation parameter values.
+     *
+     * The nodes are taken from the first oscillation parameter values.
+     * The nodes are cleared if they differ between oscillation parameter values.
+     */
+    void configureLayout()
+    {
+      using namespace std;
+
+      layout.clear();
+      slice .clear();
+
+      // nodes in L/E and cosine zenith angle of first oscillation parameter values
+
+      for (super_const_iterator i = this->super_begin(); i != this->super_end(); ++i) {
+
+	const abscissa_type x = (*i).getKey().back();
+
+	if (!layout.empty() && x <= layout.rbegin()->getX()) {
+	  break;
+	}
+
+	layout[x] = (*i).getValue();
+      }
+
+      // check nodes of other oscillation parameter values
+
+      size_t n = 0;
+
+      for (super_const_iterator i = this->super_begin(); i != this->super_end(); ++i, ++n) {
+
+	const typename slice_type::const_iterator p  = next(layout.begin(), n % layout.size());
+	const function_type&                      f1 = (*i).getValue();
+
+	if ((*i).getKey().back() != p->getX() || f1.size() != p->getY().size() ||
+	    !equal(f1.begin(), f1.end(), p->getY().begin(), [](const typename function_type::value_type& first,
+							       const typename function_type::value_type& second) { return first.getX() == second.getX(); })) {
+	  
+	  layout.clear();
+
+	  return;
+	}
+      }
+    }
+
+
+    /**
+     * Configure two-dimensional table at current oscillation parameters.
+     *
+     * The table is cleared if the oscillation parameters are not frozen,
+     * if the nodes in L/E and cosine zenith angle differ between oscillation parameter values or
+     * if the oscillation parameters are outside the range of the interpolation table.
+     */
+    void configure()
+    {
+      if (frozen && !layout.empty()) {
+
+	if (slice.empty()) {
+	  slice = layout;
+	}
+
+	if (getSlice(buffer.data(), slice)) {
+	  return;
+	}
+      }
+
+      slice.clear();
+    }
+
 
     JOscParameters      parameters;  //!< Fixed oscillation parameters corresponding to the oscillation probability table
     JBaselineCalculator getBaseline; //!< Baseline functor
+
+    JTOOLS::JArray<NUMBER_OF_DIMENSIONS, argument_type> buffer; //!< Oscillation parameter values for interpolation
+
+    bool       frozen;               //!< Option to freeze oscillation parameters
+    slice_type layout;               //!< Nodes in L/E and cosine zenith angle common to all oscillation parameter values
+    slice_type slice;                //!< Interpolation table at frozen oscillation parameters
   };
 }
 
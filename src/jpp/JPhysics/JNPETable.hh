@@ -155,9 +155,9 @@ namespace JPHYSICS {
     template<class ...Args>
     result_type operator()(const Args& ...args) const
     {
-      this->buffer.set(args...);
+      const JTOOLS::JArray<NUMBER_OF_DIMENSIONS, argument_type> buffer(args...);
 
-      return this->evaluate(this->buffer.data());
+      return this->evaluate(buffer.data());
     }
 
 
@@ -169,9 +169,7 @@ namespace JPHYSICS {
      */
     virtual result_type evaluate(const argument_type* pX) const override 
     {
-      for (int i = 0; i != NUMBER_OF_DIMENSIONS; ++i) {
-        this->buffer[i] = pX[i];
-      }
+      const JTOOLS::JArray<NUMBER_OF_DIMENSIONS, argument_type> buffer(pX);
 
       const double      W   = transformer->getWeight(buffer);
       const result_type npe = multifunction_t::evaluate(buffer.data());
@@ -207,9 +205,6 @@ namespace JPHYSICS {
 
 
     JLANG::JSharedPointer<transformer_type> transformer;
-
-  protected:
-    mutable JTOOLS::JArray<NUMBER_OF_DIMENSIONS, argument_type> buffer;
   };
 }
 
@@ -3,6 +3,7 @@
 #include "JTools/JCollection.hh"
 #include "JTools/JMap.hh"
 #include "JTools/JGridMap.hh"
+#include "JTools/JFunctionalMap_t.hh"
 #include "JTools/JMapList.hh"
 #include "JTools/JSpline.hh"
 #include "JTools/JPolint.hh"
@@ -23,12 +24,19 @@
  */
 struct JMuonNPE_t {
 
-  typedef JPP::JMAPLIST<JPP::JPolint1FunctionalMap,
+  typedef JPP::JMAPLIST<JPP::JPolint1FunctionalLookupMap,
 			JPP::JPolint1FunctionalGridMap,
 			JPP::JPolint1FunctionalGridMap>::maplist   JNPEMaplist_t;
   typedef JPP::JNPETable<double, double, JNPEMaplist_t>            JNPE_t;
 
 
+  /**
+   * Default constructor.
+   */
+  JMuonNPE_t()
+  {}
+
+
   /**
    * Constructor.
    *
@@ -37,6 +45,40 @@ struct JMuonNPE_t {
    * \param  fileDescriptor     PDF file descriptor
    */
   JMuonNPE_t(const std::string& fileDescriptor)
+  {
+    load(fileDescriptor, JPP::JSerialLoader());
+  }
+
+
+  /**
+   * Get PDF.
+   *
+   * The orientation of the PMT should be defined according this <a href="https://common.pages.km3net.de/jpp/JPDF.PDF">documentation</a>.\n
+   * In this, the zenith and azimuth angles are limited to \f[\left[0, \pi\right]\f].
+   *
+   * \param  E                  muon energy at minimum distance of approach [GeV]
+   * \param  R                  minimum distance of approach [m]
+   * \param  theta              PMT zenith  angle [rad]
+   * \param  phi                PMT azimuth angle [rad]
+   * \return                    number of photo-electrons
+   */
+  double calculate(const double E,
+		   const double R,
+		   const double theta,
+		   const double phi) const
+  {
+    return getNPE(Y1, YA, YB, E, R, theta, phi);
+  }
+
+protected:
+  /**
+   * Load PDFs and add NPE tables.
+   *
+   * \param  fileDescriptor     PDF file descriptor
+   * \param  loader             loader (see JPHYSICS::JSerialLoader)
+   */
+  template<class JLoader_t>
+  void load(const std::string& fileDescriptor, const JLoader_t& loader)
   {
     using namespace std;
     using namespace JPP;
@@ -45,70 +87,78 @@ struct JMuonNPE_t {
 				 SCATTERED_LIGHT_FROM_MUON,
 				 DIRECT_LIGHT_FROM_DELTARAYS,
 				 SCATTERED_LIGHT_FROM_DELTARAYS,
- 				 DIRECT_LIGHT_FROM_EMSHOWERS,
+				 DIRECT_LIGHT_FROM_EMSHOWERS,
 				 SCATTERED_LIGHT_FROM_EMSHOWERS };
 
     const  int N = sizeof(pdf_t) / sizeof(pdf_t[0]);
-    
+
     typedef JPP::JSplineFunction1D<JSplineElement2D<double, double>,
                                    JCollection,
                                    double>                          JFunction1D_t;
     typedef JPDFTable<JFunction1D_t, JNPEMaplist_t>                 JPDF_t;
 
+    JNPE_t npe[N];
 
     const JNPE_t::JSupervisor supervisor(new JNPE_t::JDefaultResult(zero));
 
-    for (int i = 0; i != N; ++i) {
+    loader.execute(N,
+		   [&](const size_t i) {
 
-      JPDF_t pdf;
+		     const string file_name = getFilename(fileDescriptor, pdf_t[i]);
 
-      const JPDFType_t type      = pdf_t[i];
-      const string     file_name = getFilename(fileDescriptor, type);
+		     JPDF_t pdf;
 
-      cout << "loading PDF from file " << file_name << "... " << flush;
+		     pdf.load(file_name.c_str());
 
-      pdf.load(file_name.c_str());
+		     pdf.setExceptionHandler(supervisor);
 
-      cout << "OK" << endl;
+		     npe[i] = JNPE_t(pdf);
 
-      pdf.setExceptionHandler(supervisor);
+		     loader.print("loading PDF from file " + file_name + "... OK");
+		   },
+		   [&](const size_t k) {
 
-      if      (is_bremsstrahlung(type))
-	YB.push_back(JNPE_t(pdf));
-      else if (is_deltarays(type))
-	YA.push_back(JNPE_t(pdf));
-      else
-	Y1.push_back(JNPE_t(pdf));
-    }
+		     npe[2*k + 1].add(npe[2*k]);
+		   });
 
-    // Add PDFs
+    for (int i = 1; i < N; i += 2) {
 
-    cout << "adding PDFs... " << flush;
+      if      (is_bremsstrahlung(pdf_t[i]))
+	YB.push_back(npe[i]);
+      else if (is_deltarays(pdf_t[i]))
+	YA.push_back(npe[i]);
+      else
+	Y1.push_back(npe[i]);
+    }
 
-    Y1[1].add(Y1[0]); Y1.erase(Y1.begin());
-    YA[1].add(YA[0]); YA.erase(YA.begin());
-    YB[1].add(YB[0]); YB.erase(YB.begin());
-  
-    cout << "OK" << endl;
+    loader.print("adding PDFs... OK");
   }
 
 
+  std::vector<JNPE_t> Y1;     //!< light from muon
+  std::vector<JNPE_t> YA;     //!< light from delta-rays
+  std::vector<JNPE_t> YB;     //!< light from EM showers
+
   /**
-   * Get PDF.
-   *
-   * The orientation of the PMT should be defined according this <a href="https://common.pages.km3net.de/jpp/JPDF.PDF">documentation</a>.\n
-   * In this, the zenith and azimuth angles are limited to \f[\left[0, \pi\right]\f].
+   * Get number of photo-electrons from given NPE tables.
    *
+   * \param  Y1                 NPE tables for light from muon
+   * \param  YA                 NPE tables for light from delta-rays
+   * \param  YB                 NPE tables for light from EM showers
    * \param  E                  muon energy at minimum distance of approach [GeV]
    * \param  R                  minimum distance of approach [m]
    * \param  theta              PMT zenith  angle [rad]
    * \param  phi                PMT azimuth angle [rad]
    * \return                    number of photo-electrons
    */
-  double calculate(const double E,
-		   const double R,
-		   const double theta,
-		   const double phi) const
+  template<class JNPE_type>
+  static inline double getNPE(const std::vector<JNPE_type>& Y1,
+			      const std::vector<JNPE_type>& YA,
+			      const std::vector<JNPE_type>& YB,
+			      const double E,
+			      const double R,
+			      const double theta,
+			      const double phi)
   {
     using namespace JPP;
 
@@ -122,11 +172,6 @@ struct JMuonNPE_t {
       return 0.0;
   }
 
-private:
-  std::vector<JNPE_t> Y1;     //!< light from muon
-  std::vector<JNPE_t> YA;     //!< light from delta-rays
-  std::vector<JNPE_t> YB;     //!< light from EM showers
-
   /**
    * Get number of photo-electrons.
    *
@@ -136,7 +181,8 @@ private:
    * \param  phi                azimuth angle orientation PMT [rad]
    * \return                    number of photo-electrons
    */
-  static inline double getNPE(const std::vector<JNPE_t>& NPE,
+  template<class JNPE_type>
+  static inline double getNPE(const std::vector<JNPE_type>& NPE,
 			      const double R,
 			      const double theta,
 			      const double phi)
@@ -146,7 +192,7 @@ private:
 
     double npe = 0.0;
 
-    for (vector<JNPE_t>::const_iterator i = NPE.begin(); i != NPE.end(); ++i) {
+    for (typename vector<JNPE_type>::const_iterator i = NPE.begin(); i != NPE.end(); ++i) {
 
       if (R <= i->getXmax()) {
 
@@ -174,8 +220,8 @@ private:
  */
 struct JShowerNPE_t {
 
-  typedef JPP::JMAPLIST<JPP::JPolint1FunctionalMap,
-			JPP::JPolint1FunctionalMap,
+  typedef JPP::JMAPLIST<JPP::JPolint1FunctionalLookupMap,
+			JPP::JPolint1FunctionalLookupMap,
 			JPP::JPolint1FunctionalGridMap,
 			JPP::JPolint1FunctionalGridMap>::maplist   JNPEMaplist_t;
   typedef JPP::JNPETable<double, double, JNPEMaplist_t>            JNPE_t;
@@ -8,6 +8,7 @@
 #include "JTools/JQuantiles.hh"
 #include "JTools/JSet.hh"
 #include "JTools/JRange.hh"
+#include "JTools/JQuadrature.hh"
 #include "JMath/JMathSupportkit.hh"
 #include "JPhysics/JConstants.hh"
 #include "JPhysics/JPDFTransformer.hh"
@@ -29,6 +30,7 @@ namespace JPHYSICS {
   using JTOOLS::JTransformableMultiFunction;
   using JTOOLS::JTransformableMultiHistogram;
   using JTOOLS::JRange;
+  using JTOOLS::JGaussHermite;
   
 
   /**
@@ -52,6 +54,7 @@ namespace JPHYSICS {
 
     typedef typename transformablemultifunction_type::multimap_type                  multimap_type;
     typedef typename transformablemultifunction_type::transformer_type               transformer_type;
+    typedef typename transformer_type::array_type                                    array_type;
 
     enum { NUMBER_OF_DIMENSIONS = transformablemultifunction_type::NUMBER_OF_DIMENSIONS };
 
@@ -116,74 +119,93 @@ namespace JPHYSICS {
       using namespace std;
       using namespace JPP;
 
-      typedef typename transformer_type::array_type  array_type;
-
       const JGaussHermite engine(numberOfPoints, epsilon);
 
       for (super_iterator i = this->super_begin(); i != this->super_end(); ++i) {
-	
-	const array_type array = (*i).getKey();
-	function_type&   f1    = (*i).getValue();
+	blur((*i).getKey(), (*i).getValue(), engine, TTS, quantile);
+      }
+    }
 
-	if (!f1.empty()) {
 
-	  const typename function_type::supervisor_type& supervisor = f1.getSupervisor();
+    /**
+     * Blur one-dimensional PDF at given point.
+     *
+     * This method only modifies the given one-dimensional PDF.\n
+     * It can therefore be called concurrently for different one-dimensional PDFs of this table.
+     *
+     * \param  array                abscissa values of point
+     * \param  f1                   one-dimensional PDF at given point
+     * \param  engine               Gauss-Hermite integration
+     * \param  TTS                  TTS [ns]
+     * \param  quantile             quantile
+     */
+    void blur(const array_type&    array,
+	      function_type&       f1,
+	      const JGaussHermite& engine,
+	      const double         TTS,
+	      const double         quantile) const
+    {
+      using namespace std;
+      using namespace JPP;
 
-	  const JMultiMapGetTransformer<NUMBER_OF_DIMENSIONS - 1, value_type> get(*(this->transformer), array);
-	  const JMultiMapPutTransformer<NUMBER_OF_DIMENSIONS - 1, value_type> put(*(this->transformer), array);
+      if (!f1.empty()) {
 
-	  f1.transform(get);
-	  f1.compile();
+	const typename function_type::supervisor_type& supervisor = f1.getSupervisor();
 
-	  const JQuantiles Q(f1, quantile);
+	const JMultiMapGetTransformer<NUMBER_OF_DIMENSIONS - 1, value_type> get(*(this->transformer), array);
+	const JMultiMapPutTransformer<NUMBER_OF_DIMENSIONS - 1, value_type> put(*(this->transformer), array);
 
-	  // abscissa 
+	f1.transform(get);
+	f1.compile();
 
-	  JSet<double> X;
+	const JQuantiles Q(f1, quantile);
 
-	  for (JGaussHermite::const_iterator j = engine.begin(); j != engine.end(); ++j) {
-	    X.insert(Q.getX() + TTS*sqrt(2.0)*j->getX());
-	  }
+	// abscissa 
+
+	JSet<double> X;
 
-	  for (typename function_type::const_iterator j = f1.begin(); j != f1.end(); ++j) {
+	for (JGaussHermite::const_iterator j = engine.begin(); j != engine.end(); ++j) {
+	  X.insert(Q.getX() + TTS*sqrt(2.0)*j->getX());
+	}
+
+	for (typename function_type::const_iterator j = f1.begin(); j != f1.end(); ++j) {
 
-	    if (j->getX() - TTS < X.getXmin()) {
-	      X.insert(j->getX() - TTS);
-	    }
+	  if (j->getX() - TTS < X.getXmin()) {
+	    X.insert(j->getX() - TTS);
+	  }
 	    
-	    if (j->getX() + TTS > X.getXmax()) {
-	      X.insert(j->getX() + TTS);
-	    }
+	  if (j->getX() + TTS > X.getXmax()) {
+	    X.insert(j->getX() + TTS);
 	  }
+	}
 
 
-	  const double W = gauss(Q.getUpperLimit() - Q.getLowerLimit(), TTS);
+	const double W = gauss(Q.getUpperLimit() - Q.getLowerLimit(), TTS);
 
-	  function_type buffer;
+	function_type buffer;
 
-	  for (JSet<double>::const_iterator x = X.begin(); x != X.end(); ++x) {
+	for (JSet<double>::const_iterator x = X.begin(); x != X.end(); ++x) {
 
-	    double y = 0.0;
+	  double y = 0.0;
 
-	    for (JGaussHermite::const_iterator j = engine.begin(); j != engine.end(); ++j) {
+	  for (JGaussHermite::const_iterator j = engine.begin(); j != engine.end(); ++j) {
 
-	      const double u = j->getX();
-	      const double v = j->getY() / sqrt(PI);
-	      const double w = get_value(f1(*x + u*TTS*sqrt(2.0)));
+	    const double u = j->getX();
+	    const double v = j->getY() / sqrt(PI);
+	    const double w = get_value(f1(*x + u*TTS*sqrt(2.0)));
 	
-	      y += v * w;
-	    }
-
-	    buffer[*x]  =  W * Q.getIntegral() * Gauss(*x - Q.getX(), TTS)  +  (1.0 - W) * y;
+	    y += v * w;
 	  }
 
-	  buffer.transform(put);
-	  buffer.compile();
+	  buffer[*x]  =  W * Q.getIntegral() * Gauss(*x - Q.getX(), TTS)  +  (1.0 - W) * y;
+	}
 
-	  f1 = buffer;
+	buffer.transform(put);
+	buffer.compile();
 
-	  f1.setExceptionHandler(supervisor);
-	}
+	f1 = buffer;
+
+	f1.setExceptionHandler(supervisor);
       }
     }
 
@@ -3,6 +3,7 @@
 
 #include <string>
 #include <sstream>
+#include <iostream>
 
 #include "Jeep/JeepToolkit.hh"
 
@@ -114,6 +115,50 @@ namespace JPHYSICS {
   }
 
 
+  /**
+   * Auxiliary data structure for serial loading of PDF files.
+   *
+   * The PDF files are loaded by the first function and each pair of consecutive PDF files is processed by the second function.\n
+   * Other data structures with the same interface can be used to load the PDF files concurrently.
+   */
+  struct JSerialLoader {
+    /**
+     * Execute functions for PDF files.
+     *
+     * The first function is called for each PDF file <tt>i</tt> in <tt>[0, n)</tt>.\n
+     * The second function is called for pair <tt>k</tt> after the first function has been completed
+     * for both PDF files <tt>2 k</tt> and <tt>2 k + 1</tt>.
+     *
+     * \param  n                  number of PDF files
+     * \param  first              function for PDF file
+     * \param  second             function for pair of PDF files
+     */
+    template<class JFirst_t, class JSecond_t>
+    void execute(const size_t n, JFirst_t first, JSecond_t second) const
+    {
+      for (size_t i = 0; i != n; ++i) {
+
+	first(i);
+
+	if (i % 2 == 1) {
+	  second(i / 2);
+	}
+      }
+    }
+
+
+    /**
+     * Print line to standard output.
+     *
+     * \param  line               line
+     */
+    void print(const std::string& line) const
+    {
+      std::cout << line << std::endl;
+    }
+  };
+
+
   /**
    * Test if given PDF type corresponds to Cherenkov light from muon.
    *
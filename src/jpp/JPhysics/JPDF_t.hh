@@ -1,7 +1,11 @@
+#include <string>
+#include <vector>
+
 #include "JLang/JException.hh"
 #include "JTools/JCollection.hh"
 #include "JTools/JMap.hh"
 #include "JTools/JGridMap.hh"
+#include "JTools/JFunctionalMap_t.hh"
 #include "JTools/JMapList.hh"
 #include "JTools/JSpline.hh"
 #include "JTools/JPolint.hh"
@@ -29,7 +33,7 @@ struct JPDF {
 				 JPP::JCollection, 
 				 JPP::JResultPDF<double> >         JFunction1D_t;
 
-  typedef JPP::JMAPLIST<JPP::JPolint1FunctionalMap,
+  typedef JPP::JMAPLIST<JPP::JPolint1FunctionalLookupMap,
 			JPP::JPolint0FunctionalGridMap,
 			JPP::JPolint0FunctionalGridMap>::maplist   JPDFMaplist_t;
   typedef JPP::JPDFTable<JFunction1D_t, JPDFMaplist_t>             JPDF_t;
@@ -138,13 +142,20 @@ struct JMuonPDF_t {
 				 JPP::JCollection, 
 				 JPP::JResultPDF<double> >         JFunction1D_t;
 
-  typedef JPP::JMAPLIST<JPP::JPolint1FunctionalMap,
+  typedef JPP::JMAPLIST<JPP::JPolint1FunctionalLookupMap,
 			JPP::JPolint0FunctionalGridMap,
 			JPP::JPolint0FunctionalGridMap>::maplist   JPDFMaplist_t;
   typedef JPP::JPDFTable<JFunction1D_t, JPDFMaplist_t>             JPDF_t;
   typedef JFunction1D_t::result_type                               result_type;
 
 
+  /**
+   * Default constructor.
+   */
+  JMuonPDF_t()
+  {}
+
+
   /**
    * Constructor.
    *
@@ -164,41 +175,7 @@ struct JMuonPDF_t {
     using namespace std;
     using namespace JPP;
 
-    const JPDFType_t pdf_t[] = { DIRECT_LIGHT_FROM_MUON,
-				 SCATTERED_LIGHT_FROM_MUON,
-				 DIRECT_LIGHT_FROM_EMSHOWERS,
-				 SCATTERED_LIGHT_FROM_EMSHOWERS,
-				 DIRECT_LIGHT_FROM_DELTARAYS,
-				 SCATTERED_LIGHT_FROM_DELTARAYS };
-
-    const  int N = sizeof(pdf_t) / sizeof(pdf_t[0]);
-    
-    JPDF_t pdf[N];
-
-    const JPDF_t::JSupervisor supervisor(new JPDF_t::JDefaultResult(zero));
-
-    for (int i = 0; i != N; ++i) {
-
-      const string file_name = getFilename(fileDescriptor, pdf_t[i]);
-
-      cout << "loading input from file " << file_name << "... " << flush;
-
-      pdf[i].load(file_name.c_str());
-
-      pdf[i].setExceptionHandler(supervisor);
-
-      cout << "OK" << endl;
-    }
-
-    // Add PDFs
-
-    cout << "adding PDFs... " << flush;
-
-    pdfA = pdf[1];  pdfA.add(pdf[0]);
-    pdfB = pdf[3];  pdfB.add(pdf[2]);
-    pdfC = pdf[5];  pdfC.add(pdf[4]);
-
-    cout << "OK" << endl;
+    load(fileDescriptor, JSerialLoader());
 
     if        (TTS > 0.0) {
 
@@ -217,6 +194,35 @@ struct JMuonPDF_t {
   }
 
 
+  /**
+   * Get file names of PDFs.
+   *
+   * The PDF files of direct and scattered light are consecutive.
+   *
+   * \param  fileDescriptor     PDF file descriptor
+   * \return                    file names
+   */
+  static std::vector<std::string> getFilenames(const std::string& fileDescriptor)
+  {
+    using namespace JPP;
+
+    const JPDFType_t pdf_t[] = { DIRECT_LIGHT_FROM_MUON,
+				 SCATTERED_LIGHT_FROM_MUON,
+				 DIRECT_LIGHT_FROM_EMSHOWERS,
+				 SCATTERED_LIGHT_FROM_EMSHOWERS,
+				 DIRECT_LIGHT_FROM_DELTARAYS,
+				 SCATTERED_LIGHT_FROM_DELTARAYS };
+
+    std::vector<std::string> buffer;
+
+    for (const JPDFType_t type : pdf_t) {
+      buffer.push_back(getFilename(fileDescriptor, type));
+    }
+
+    return buffer;
+  }
+
+
   /**
    * Get PDF.
    *
@@ -236,11 +242,82 @@ struct JMuonPDF_t {
 			const double phi,
 			const double t1) const
   {
+    return getPDF(pdfA, pdfB, pdfC, E, R, theta, phi, t1);
+  }
+
+  JPDF_t pdfA;   //!< PDF for minimum ionising particle
+  JPDF_t pdfB;   //!< PDF for average energy losses
+  JPDF_t pdfC;   //!< PDF for delta-rays
+
+protected:
+  /**
+   * Load and add PDFs.
+   *
+   * \param  fileDescriptor     PDF file descriptor
+   * \param  loader             loader (see JPHYSICS::JSerialLoader)
+   */
+  template<class JLoader_t>
+  void load(const std::string& fileDescriptor, const JLoader_t& loader)
+  {
+    using namespace std;
     using namespace JPP;
 
-    result_type h1 = (pdfA(R, theta, phi, t1)                               +
-		      pdfB(R, theta, phi, t1) * E                           +
-		      pdfC(R, theta, phi, t1) * getDeltaRaysFromMuon(E));
+    const vector<string> file_names = getFilenames(fileDescriptor);
+
+    vector<JPDF_t> pdf(file_names.size());
+
+    JPDF_t* const out[] = { &pdfA, &pdfB, &pdfC };
+
+    const JPDF_t::JSupervisor supervisor(new JPDF_t::JDefaultResult(zero));
+
+    loader.execute(file_names.size(),
+		   [&](const size_t i) {
+
+		     pdf[i].load(file_names[i].c_str());
+
+		     pdf[i].setExceptionHandler(supervisor);
+
+		     loader.print("loading input from file " + file_names[i] + "... OK");
+		   },
+		   [&](const size_t k) {
+
+		     *out[k] = pdf[2*k + 1];  out[k]->add(pdf[2*k]);
+		   });
+
+    loader.print("adding PDFs... OK");
+  }
+
+
+  /**
+   * Get PDF from given tables.
+   *
+   * The tables should be callable as <tt>table(R, theta, phi, t1)</tt>.
+   *
+   * \param  A                  PDF for minimum ionising particle
+   * \param  B                  PDF for average energy losses
+   * \param  C                  PDF for delta-rays
+   * \param  E                  muon energy at minimum distance of approach [GeV]
+   * \param  R                  minimum distance of approach [m]
+   * \param  theta              PMT zenith  angle [rad]
+   * \param  phi                PMT azimuth angle [rad]
+   * \param  t1                 arrival time relative to Cherenkov hypothesis [ns]
+   * \return                    hypothesis value
+   */
+  template<class JTable_t>
+  static inline result_type getPDF(const JTable_t& A,
+				   const JTable_t& B,
+				   const JTable_t& C,
+				   const double    E,
+				   const double    R,
+				   const double    theta,
+				   const double    phi,
+				   const double    t1)
+  {
+    using namespace JPP;
+
+    result_type h1 = (A(R, theta, phi, t1)                               +
+		      B(R, theta, phi, t1) * E                           +
+		      C(R, theta, phi, t1) * getDeltaRaysFromMuon(E));
 
     // safety measures
 
@@ -255,10 +332,6 @@ struct JMuonPDF_t {
           
     return h1;
   }
-
-  JPDF_t pdfA;   //!< PDF for minimum ionising particle
-  JPDF_t pdfB;   //!< PDF for average energy losses
-  JPDF_t pdfC;   //!< PDF for delta-rays
 };
 
 
@@ -271,14 +344,21 @@ struct JShowerPDF_t {
 				 JPP::JCollection,
 				 JPP::JResultPDF<double> >         JFunction1D_t;
 
-  typedef JPP::JMAPLIST<JPP::JPolint1FunctionalMap,
-			JPP::JPolint1FunctionalMap,
+  typedef JPP::JMAPLIST<JPP::JPolint1FunctionalLookupMap,
+			JPP::JPolint1FunctionalLookupMap,
 			JPP::JPolint0FunctionalGridMap,
 			JPP::JPolint0FunctionalGridMap>::maplist   JPDFMaplist_t;
   typedef JPP::JPDFTable<JFunction1D_t, JPDFMaplist_t>             JPDF_t;
   typedef JFunction1D_t::result_type                               result_type;
 
 
+  /**
+   * Default constructor.
+   */
+  JShowerPDF_t()
+  {}
+
+
   /**
    * Constructor.
    *
@@ -298,32 +378,7 @@ struct JShowerPDF_t {
     using namespace std;
     using namespace JPP;
 
-    const JPDFType_t pdf_t[] = { SCATTERED_LIGHT_FROM_EMSHOWER,
-				 DIRECT_LIGHT_FROM_EMSHOWER };
-
-    const  int N = sizeof(pdf_t) / sizeof(pdf_t[0]);
-
-    const JPDF_t::JSupervisor supervisor(new JPDF_t::JDefaultResult(zero));
-
-    for (int i = 0; i != N; ++i) {
-
-      const string file_name = getFilename(fileDescriptor, pdf_t[i]);
-
-      cout << "loading input from file " << file_name << "... " << flush;
-
-      JPDF_t pdf;
-
-      pdf.load(file_name.c_str());
-
-      pdf.setExceptionHandler(supervisor);
-
-      if (pdfA.empty())
-	pdfA = pdf;
-      else
-	pdfA.add(pdf);
-
-      cout << "OK" << endl;
-    }
+    load(fileDescriptor, JSerialLoader());
 
     if        (TTS > 0.0) {
 
@@ -340,6 +395,23 @@ struct JShowerPDF_t {
   }
 
 
+  /**
+   * Get file names of PDFs.
+   *
+   * The PDF files of direct and scattered light are consecutive.
+   *
+   * \param  fileDescriptor     PDF file descriptor
+   * \return                    file names
+   */
+  static std::vector<std::string> getFilenames(const std::string& fileDescriptor)
+  {
+    using namespace JPP;
+
+    return { getFilename(fileDescriptor, DIRECT_LIGHT_FROM_EMSHOWER),
+	     getFilename(fileDescriptor, SCATTERED_LIGHT_FROM_EMSHOWER) };
+  }
+
+
   /**
    * Get PDF.
    *
@@ -380,4 +452,40 @@ struct JShowerPDF_t {
   }
 
   JPDF_t pdfA;   //!< PDF for shower
+
+protected:
+  /**
+   * Load and add PDFs.
+   *
+   * \param  fileDescriptor     PDF file descriptor
+   * \param  loader             loader (see JPHYSICS::JSerialLoader)
+   */
+  template<class JLoader_t>
+  void load(const std::string& fileDescriptor, const JLoader_t& loader)
+  {
+    using namespace std;
+    using namespace JPP;
+
+    const vector<string> file_names = getFilenames(fileDescriptor);
+
+    JPDF_t pdf;
+
+    const JPDF_t::JSupervisor supervisor(new JPDF_t::JDefaultResult(zero));
+
+    loader.execute(file_names.size(),
+		   [&](const size_t i) {
+
+		     JPDF_t& out = (i == 1 ? pdfA : pdf);
+
+		     out.load(file_names[i].c_str());
+
+		     out.setExceptionHandler(supervisor);
+
+		     loader.print("loading input from file " + file_names[i] + "... OK");
+		   },
+		   [&](const size_t) {
+
+		     pdfA.add(pdf);
+		   });
+  }
 };
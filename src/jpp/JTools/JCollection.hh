@@ -5,6 +5,7 @@
 #include <cmath>
 #include <limits>
 #include <algorithm>
+#include <iterator>
 
 #include "JLang/JClass.hh"
 #include "JLang/JException.hh"
@@ -36,6 +37,26 @@ namespace JTOOLS {
   using JLANG::JException;
   
 
+  /**
+   * Cursor for consecutive searches in a collection.
+   *
+   * The cursor holds the position of the result of the previous search,
+   * which is used as starting point of the next search (see JCollection::lower_bound).\n
+   * A cursor is owned by the caller, so that concurrent searches in the same collection can use separate cursors.
+   */
+  struct JCursor {
+    /**
+     * Default constructor.
+     */
+    JCursor() :
+      index(0)
+    {}
+
+
+    size_t index;     //!< position of previous result
+  };
+
+
   /**
    * General purpose class for collection of elements, see:
    \htmlonly
@@ -307,6 +328,92 @@ namespace JTOOLS {
     }
 
 
+    /**
+     * Get first position of element <tt>i</tt>, where <tt>x >= i->getX()</tt>.
+     *
+     * The search starts at the position of the previous result held by the given cursor
+     * and the step size is doubled until the position is bracketed, followed by a binary search.\n
+     * The number of comparisons is hence proportional to the logarithm of the distance between consecutive results.
+     * The cursor is set to the position of the result.
+     *
+     * \param  x               abscissa value
+     * \param  cursor          cursor
+     * \return                 position of corresponding element
+     */
+    const_iterator lower_bound(typename JClass<abscissa_type>::argument_type x, JCursor& cursor) const
+    {
+      const const_iterator p = this->begin();
+      const size_t         n = this->size();
+
+      size_t k = std::min(cursor.index, n);
+      size_t i;
+      size_t j;
+
+      if (k != n && compare(p[k], x)) {
+
+	for (size_t step = 1; ; step <<= 1) {
+
+	  i = k + 1;
+
+	  if (n - k <= step) {
+	    j = n;
+	    break;
+	  }
+
+	  if (!compare(p[k + step], x)) {
+	    j = k + step;
+	    break;
+	  }
+
+	  k += step;
+	}
+
+      } else {
+
+	j = k;
+
+	for (size_t step = 1; ; step <<= 1) {
+
+	  if (k < step) {
+	    i = 0;
+	    break;
+	  }
+
+	  if (compare(p[k - step], x)) {
+	    i = k - step + 1;
+	    break;
+	  }
+
+	  j = k -= step;
+	}
+      }
+
+      const const_iterator q = std::lower_bound(p + i, p + j, x, compare);
+
+      cursor.index = std::distance(p, q);
+
+      return q;
+    }
+
+
+    /**
+     * Get first position of element <tt>i</tt>, where <tt>x >= i->getX()</tt>.
+     *
+     * The search starts at the position of the previous result held by the given cursor.
+     * The cursor is set to the position of the result.
+     *
+     * \param  x               abscissa value
+     * \param  cursor          cursor
+     * \return                 position of corresponding element
+     */
+    iterator lower_bound(typename JClass<abscissa_type>::argument_type x, JCursor& cursor)
+    {
+      static_cast<const JCollection&>(*this).lower_bound(x, cursor);
+
+      return this->begin() + cursor.index;
+    }
+
+
     /**
      * Insert element.
      *
@@ -756,6 +863,16 @@ namespace JTOOLS {
     }
 
 
+    /**
+     * Update auxiliary data structure for the search of abscissa values.
+     *
+     * This method is called at the compilation of interpolating functions (see e.g.\ JLookupCollection).\n
+     * This collection has no such data structure.
+     */
+    void updateIndex()
+    {}
+
+
     /**
      * Get comparator.
      *
@@ -4,6 +4,7 @@
 #include "JTools/JDistance.hh"
 #include "JTools/JMap.hh"
 #include "JTools/JGridMap.hh"
+#include "JTools/JLookupMap.hh"
 #include "JTools/JPolint.hh"
 #include "JTools/JSpline.hh"
 #include "JTools/JResult.hh"
@@ -111,6 +112,51 @@ namespace JTOOLS {
   {};
 
 
+  /**
+   * Type definition of a spline interpolation based on a JLookupMap implementation.
+   */
+  template<class JKey_t, class JValue_t, class JDistance_t = JDistance<JKey_t> >
+  struct JSplineFunctionalLookupMap :
+    public JSplineMap<JKey_t, JValue_t, JLookupMap, typename JResultType<JValue_t>::result_type, JDistance_t>
+  {};
+
+
+  /**
+   * Type definition of a zero degree polynomial interpolation based on a JLookupMap implementation.
+   */
+  template<class JKey_t, class JValue_t, class JDistance_t = JDistance<JKey_t> >
+  struct JPolint0FunctionalLookupMap :
+    public JPolintMap<0, JKey_t, JValue_t, JLookupMap, typename JResultType<JValue_t>::result_type, JDistance_t>
+  {};
+
+
+  /**
+   * Type definition of a 1st degree polynomial interpolation based on a JLookupMap implementation.
+   */
+  template<class JKey_t, class JValue_t, class JDistance_t = JDistance<JKey_t> >
+  struct JPolint1FunctionalLookupMap :
+    public JPolintMap<1, JKey_t, JValue_t, JLookupMap, typename JResultType<JValue_t>::result_type, JDistance_t>
+  {};
+
+
+  /**
+   * Type definition of a 2nd degree polynomial interpolation based on a JLookupMap implementation.
+   */
+  template<class JKey_t, class JValue_t, class JDistance_t = JDistance<JKey_t> >
+  struct JPolint2FunctionalLookupMap :
+    public JPolintMap<2, JKey_t, JValue_t, JLookupMap, typename JResultType<JValue_t>::result_type, JDistance_t>
+  {};
+
+
+  /**
+   * Type definition of a 3rd degree polynomial interpolation based on a JLookupMap implementation.
+   */
+  template<class JKey_t, class JValue_t, class JDistance_t = JDistance<JKey_t> >
+  struct JPolint3FunctionalLookupMap :
+    public JPolintMap<3, JKey_t, JValue_t, JLookupMap, typename JResultType<JValue_t>::result_type, JDistance_t>
+  {};
+
+
   /**
    * Type definition of a spline interpolation based on a JMap implementation.
    */
@@ -199,6 +245,51 @@ namespace JTOOLS {
   struct JPolint3FunctionalGridMapH :
     public JPolintMap<3, JKey_t, JValue_t, JGridMap, JResultDerivative<typename JResultType<JValue_t>::result_type>, JDistance_t>
   {};
+
+
+  /**
+   * Type definition of a spline interpolation based on a JLookupMap implementation.
+   */
+  template<class JKey_t, class JValue_t, class JDistance_t = JDistance<JKey_t> >
+  struct JSplineFunctionalLookupMapH :
+    public JSplineMap<JKey_t, JValue_t, JLookupMap, JResultDerivative<typename JResultType<JValue_t>::result_type>, JDistance_t>
+  {};
+
+
+  /**
+   * Type definition of a zero degree polynomial interpolation based on a JLookupMap implementation.
+   */
+  template<class JKey_t, class JValue_t, class JDistance_t = JDistance<JKey_t> >
+  struct JPolint0FunctionalLookupMapH :
+    public JPolintMap<0, JKey_t, JValue_t, JLookupMap, JResultDerivative<typename JResultType<JValue_t>::result_type>, JDistance_t>
+  {};
+
+
+  /**
+   * Type definition of a 1st degree polynomial interpolation based on a JLookupMap implementation.
+   */
+  template<class JKey_t, class JValue_t, class JDistance_t = JDistance<JKey_t> >
+  struct JPolint1FunctionalLookupMapH :
+    public JPolintMap<1, JKey_t, JValue_t, JLookupMap, JResultDerivative<typename JResultType<JValue_t>::result_type>, JDistance_t>
+  {};
+
+
+  /**
+   * Type definition of a 2nd degree polynomial interpolation based on a JLookupMap implementation.
+   */
+  template<class JKey_t, class JValue_t, class JDistance_t = JDistance<JKey_t> >
+  struct JPolint2FunctionalLookupMapH :
+    public JPolintMap<2, JKey_t, JValue_t, JLookupMap, JResultDerivative<typename JResultType<JValue_t>::result_type>, JDistance_t>
+  {};
+
+
+  /**
+   * Type definition of a 3rd degree polynomial interpolation based on a JLookupMap implementation.
+   */
+  template<class JKey_t, class JValue_t, class JDistance_t = JDistance<JKey_t> >
+  struct JPolint3FunctionalLookupMapH :
+    public JPolintMap<3, JKey_t, JValue_t, JLookupMap, JResultDerivative<typename JResultType<JValue_t>::result_type>, JDistance_t>
+  {};
 }
 
 #endif
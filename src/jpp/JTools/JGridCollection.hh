@@ -1,6 +1,8 @@
 #ifndef __JTOOLS__JGRIDCOLLECTION__
 #define __JTOOLS__JGRIDCOLLECTION__
 
+#include <iterator>
+
 #include "JLang/JClass.hh"
 #include "JTools/JCollection.hh"
 
@@ -105,6 +107,44 @@ namespace JTOOLS {
       else
 	return this->begin() + index;
     }
+
+
+    /**
+     * Get first position of element <tt>i</tt>, where <tt>x >= i->getX()</tt>.
+     *
+     * The position is directly computed; the cursor is only set to the position of the result.
+     *
+     * \param  x               abscissa value
+     * \param  cursor          cursor
+     * \return                 position of corresponding element
+     */
+    const_iterator lower_bound(typename JClass<abscissa_type>::argument_type x, JCursor& cursor) const
+    {
+      const const_iterator p = this->lower_bound(x);
+
+      cursor.index = std::distance(this->begin(), p);
+
+      return p;
+    }
+
+
+    /**
+     * Get first position of element <tt>i</tt>, where <tt>x >= i->getX()</tt>.
+     *
+     * The position is directly computed; the cursor is only set to the position of the result.
+     *
+     * \param  x               abscissa value
+     * \param  cursor          cursor
+     * \return                 position of corresponding element
+     */
+    iterator lower_bound(typename JClass<abscissa_type>::argument_type x, JCursor& cursor)
+    {
+      const iterator p = this->lower_bound(x);
+
+      cursor.index = std::distance(this->begin(), p);
+
+      return p;
+    }
   };
 }
 
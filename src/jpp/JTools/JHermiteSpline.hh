@@ -72,6 +72,8 @@ namespace JTOOLS {
     void compile(const bool monotone)
     {
       using namespace std;
+
+      this->updateIndex();
       
       if (this->size() >= 2u) {
 
@@ -613,6 +615,8 @@ namespace JTOOLS {
      */
     virtual void do_compile() override 
     {
+      this->updateIndex();
+
       buffer.clear();
 
       for (iterator i = this->begin(); i != this->end(); ++i) {
@@ -0,0 +1,400 @@
+#ifndef __JTOOLS__JLOOKUPCOLLECTION__
+#define __JTOOLS__JLOOKUPCOLLECTION__
+
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <algorithm>
+#include <iterator>
+
+#include "JLang/JClass.hh"
+#include "JTools/JCollection.hh"
+
+
+/**
+ * \file
+ *
+ * Collection of non-equidistant elements with index for the search of abscissa values.
+ */
+namespace JTOOLS {}
+namespace JPP { using namespace JTOOLS; }
+
+namespace JTOOLS {
+
+  using JLANG::JClass;
+
+
+  /**
+   * General purpose class for collection of non-equidistant elements.
+   *
+   * The abscissa range of the collection is divided in buckets which are equidistant
+   * in either the abscissa value or the logarithm of the abscissa value,
+   * whichever corresponds best to the distribution of the elements.
+   * For the logarithm, the binary representation of double precision values is used,
+   * which is linear between powers of two.
+   * For each bucket, the index holds the position of the first element in or after this bucket.
+   * The lower_bound methods are re-implemented in this class,
+   * so that the search of an abscissa value is limited to the elements of the corresponding bucket.\n
+   * The number of buckets is chosen such that each bucket contains at most one element,
+   * up to a maximum of JLookupCollection::MAXIMUM_NUMBER_OF_BUCKETS_PER_ELEMENT times the number of elements.
+   *
+   * The index is updated at the compilation of the interpolating function (see method updateIndex)
+   * and it is cleared when elements are added or removed.
+   * As long as the index is not up-to-date, a binary search is made.
+   */
+  template<class JElement_t, class JDistance_t = JDistance<typename JElement_t::abscissa_type> >
+  class JLookupCollection :
+    public JCollection<JElement_t, JDistance_t>
+  {
+  public:
+
+    typedef JCollection<JElement_t, JDistance_t>                            collection_type;
+
+    typedef typename collection_type::abscissa_type                         abscissa_type;
+    typedef typename collection_type::ordinate_type                         ordinate_type;
+    typedef typename collection_type::value_type                            value_type;
+
+    typedef typename collection_type::const_iterator                        const_iterator;
+    typedef typename collection_type::const_reverse_iterator                const_reverse_iterator;
+    typedef typename collection_type::iterator                              iterator;
+    typedef typename collection_type::reverse_iterator                      reverse_iterator;
+
+
+    static const size_t MAXIMUM_NUMBER_OF_BUCKETS_PER_ELEMENT = 2;     //!< maximal number of buckets per element
+
+
+    /**
+     * Default constructor.
+     */
+    JLookupCollection() :
+      xmin(),
+      scale(0.0),
+      logarithmic(false)
+    {}
+
+
+    /**
+     * Clear.
+     */
+    virtual void clear() override 
+    {
+      index.clear();
+
+      collection_type::clear();
+    }
+
+
+    /**
+     * Get ordinate value.
+     *
+     * The index is cleared, as the element is added if not yet present.
+     *
+     * \param  x               abscissa value
+     * \return                 ordinate value
+     */
+    virtual ordinate_type& get(typename JClass<abscissa_type>::argument_type x) override 
+    {
+      index.clear();
+
+      return collection_type::get(x);
+    }
+
+
+    /**
+     * Get ordinate value.
+     *
+     * \param  x               abscissa value
+     * \return                 ordinate value
+     */
+    virtual const ordinate_type& get(typename JClass<abscissa_type>::argument_type x) const override 
+    {
+      return collection_type::get(x);
+    }
+
+
+    /**
+     * Insert element.
+     *
+     * \param  element         element
+     * \return                 (iterator, status), where status is true if inserted; else false
+     */
+    typename collection_type::pair_type insert(const value_type& element)
+    {
+      index.clear();
+
+      return collection_type::insert(element);
+    }
+
+
+    /**
+     * Transform collection.
+     *
+     * \param  transformer     element transformer
+     */
+    void transform(const typename collection_type::transformer_type& transformer)
+    {
+      index.clear();
+
+      collection_type::transform(transformer);
+    }
+
+
+    /**
+     * Configure collection.
+     *
+     * \param  bounds          abscissa values
+     * \param  args            ordinate value or function
+     */
+    template<class ...Args>
+    void configure(const JAbstractCollection<abscissa_type>& bounds, const Args& ...args)
+    {
+      index.clear();
+
+      collection_type::configure(bounds, args...);
+    }
+
+
+    /**
+     * Read collection from input.
+     *
+     * \param  in              reader
+     * \param  collection      collection
+     * \return                 reader
+     */
+    friend inline JReader& operator>>(JReader& in, JLookupCollection& collection)
+    {
+      collection.index.clear();
+
+      return in >> static_cast<collection_type&>(collection);
+    }
+
+
+    /**
+     * Update index.
+     */
+    void updateIndex()
+    {
+      using namespace std;
+
+      index.clear();
+
+      const size_t n = this->size();
+
+      if (n < 2u) {
+	return;
+      }
+
+      xmin = this->begin()->getX();
+
+      // coordinate of buckets
+
+      logarithmic = false;
+
+      double xspan = getCoordinate(this->rbegin()->getX());
+      double nx    = getNumberOfBuckets();
+
+      if (xmin > 0.0) {
+
+	logarithmic = true;
+
+	const double ny = getNumberOfBuckets();
+
+	if (ny < nx) {
+	  xspan = getCoordinate(this->rbegin()->getX());
+	  nx    = ny;
+	} else {
+	  logarithmic = false;
+	}
+      }
+
+      if (!(xspan > 0.0)) {
+	return;
+      }
+
+      const size_t m = (size_t) min(ceil(nx), (double) (MAXIMUM_NUMBER_OF_BUCKETS_PER_ELEMENT * n));
+
+      scale = m / xspan;
+
+      index.resize(m + 2);
+
+      size_t k = 0;
+      size_t i = 0;
+
+      for (const_iterator p = this->begin(); p != this->end(); ++p, ++i) {
+	for (const size_t bucket = getBucket(p->getX()); k <= bucket; ++k) {
+	  index[k] = i;
+	}
+      }
+
+      for ( ; k != index.size(); ++k) {
+	index[k] = n;
+      }
+    }
+
+
+    /**
+     * Get first position of element <tt>i</tt>, where <tt>x >= i->getX()</tt>.
+     *
+     * \param  x               abscissa value
+     * \return                 position of corresponding element
+     */
+    const_iterator lower_bound(typename JClass<abscissa_type>::argument_type x) const
+    {
+      if (index.empty() || index.back() != this->size()) {
+	return collection_type::lower_bound(x);
+      }
+
+      const size_t bucket = getBucket(x);
+
+      return std::lower_bound(this->begin() + index[bucket], this->begin() + index[bucket + 1], x, this->compare);
+    }
+
+
+    /**
+     * Get first position of element <tt>i</tt>, where <tt>x >= i->getX()</tt>.
+     *
+     * \param  x               abscissa value
+     * \return                 position of corresponding element
+     */
+    iterator lower_bound(typename JClass<abscissa_type>::argument_type x)
+    {
+      return this->begin() + std::distance(static_cast<const JLookupCollection&>(*this).begin(),
+					   static_cast<const JLookupCollection&>(*this).lower_bound(x));
+    }
+
+
+    /**
+     * Get first position of element <tt>i</tt>, where <tt>x >= i->getX()</tt>.
+     *
+     * The position is determined using the index; the cursor is only set to the position of the result.
+     *
+     * \param  x               abscissa value
+     * \param  cursor          cursor
+     * \return                 position of corresponding element
+     */
+    const_iterator lower_bound(typename JClass<abscissa_type>::argument_type x, JCursor& cursor) const
+    {
+      const const_iterator p = this->lower_bound(x);
+
+      cursor.index = std::distance(this->begin(), p);
+
+      return p;
+    }
+
+
+    /**
+     * Get first position of element <tt>i</tt>, where <tt>x >= i->getX()</tt>.
+     *
+     * The position is determined using the index; the cursor is only set to the position of the result.
+     *
+     * \param  x               abscissa value
+     * \param  cursor          cursor
+     * \return                 position of corresponding element
+     */
+    iterator lower_bound(typename JClass<abscissa_type>::argument_type x, JCursor& cursor)
+    {
+      const iterator p = this->lower_bound(x);
+
+      cursor.index = std::distance(this->begin(), p);
+
+      return p;
+    }
+
+
+  protected:
+    /**
+     * Get coordinate of given abscissa value for the division in buckets.
+     *
+     * \param  x               abscissa value
+     * \return                 coordinate
+     */
+    double getCoordinate(typename JClass<abscissa_type>::argument_type x) const
+    {
+      if (logarithmic)
+	return (double) getBits(x) - (double) getBits(xmin);
+      else
+	return this->getDistance(xmin, x);
+    }
+
+
+    /**
+     * Get binary representation of given value.
+     *
+     * For positive values, the result increases monotonically with the logarithm of the value.
+     *
+     * \param  x               value
+     * \return                 binary representation
+     */
+    static int64_t getBits(const double x)
+    {
+      int64_t i;
+
+      std::memcpy(&i, &x, sizeof(i));
+
+      return i;
+    }
+
+
+    /**
+     * Get number of buckets such that each bucket contains at most one element.
+     *
+     * \return                 number of buckets
+     */
+    double getNumberOfBuckets() const
+    {
+      using namespace std;
+
+      double dx = numeric_limits<double>::max();
+
+      for (const_iterator j = this->begin(), i = j++; j != this->end(); ++i, ++j) {
+
+	const double d = getCoordinate(j->getX()) - getCoordinate(i->getX());
+
+	if (d > 0.0 && d < dx) {
+	  dx = d;
+	}
+      }
+
+      return getCoordinate(this->rbegin()->getX()) / dx;
+    }
+
+
+    /**
+     * Get bucket of given abscissa value.
+     *
+     * Abscissa values outside the range of this collection are assigned to the first or last bucket.
+     * Abscissa values which are not comparable (i.e.\ NaN) are assigned to the first bucket,
+     * consistent with the binary search.
+     *
+     * \param  x               abscissa value
+     * \return                 bucket
+     */
+    size_t getBucket(typename JClass<abscissa_type>::argument_type x) const
+    {
+      const size_t m = index.size() - 2;
+
+      if (!(x > xmin)) {
+	return 0;
+      }
+
+      const double u = getCoordinate(x) * scale;
+
+      if (!(u > 0.0))
+	return 0;
+      else if (u >= m)
+	return m;
+      else
+	return (size_t) u;
+    }
+
+
+    std::vector<unsigned int> index;
+    abscissa_type       xmin;
+    double              scale;
+    bool                logarithmic;
+  };
+}
+
+#endif
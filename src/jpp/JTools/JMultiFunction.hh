@@ -173,15 +173,13 @@ namespace JTOOLS {
     template<class ...Args>
     result_type operator()(const Args& ...args) const
     {
-      buffer.set(args...);
+      const JArray<NUMBER_OF_DIMENSIONS, argument_type> buffer(args...);
 
       return this->evaluate(buffer.data());
     }
 
 
   protected:
-    mutable JArray<NUMBER_OF_DIMENSIONS, argument_type> buffer;
-
     /**
      * Insert multidimensional histogram at multidimensional key.
      *
@@ -4,6 +4,7 @@
 #include <cmath>
 #include <iterator>
 #include <algorithm>
+#include <type_traits>
 
 #include "JLang/JException.hh"
 #include "JLang/JAssert.hh"
@@ -14,6 +15,7 @@
 #include "JTools/JResult.hh"
 #include "JTools/JElement.hh"
 #include "JTools/JMapCollection.hh"
+#include "JTools/JGridCollection.hh"
 #include "JTools/JQuadrature.hh"
 
 
@@ -32,6 +34,241 @@ namespace JTOOLS {
   using JLANG::JValueOutOfRange;
 
 
+  /**
+   * Auxiliary class for polynomial interpolation with a fixed number of points.
+   *
+   * The loops of Neville's algorithm are unrolled at compile time.
+   * As the tableau is evaluated without selecting a path through it,
+   * the resulting code has no branches and all intermediate values can be kept in registers.\n
+   * For equidistant points, the Lagrange polynomials are evaluated using barycentric weights
+   * which are computed at compile time.
+   * The result of the Lagrange form is not bit-identical to that of Neville's algorithm;
+   * the difference is of the order of the rounding error (i.e.\ about <tt>10<sup>-14</sup></tt> relative to the values).
+   *
+   * The value at a point which coincides with the abscissa value is taken as is.
+   * The number of points should be at least two.
+   */
+  template<int n>
+  struct JPolintKernel
+  {
+    /**
+     * Neville's algorithm.
+     *
+     * The interpolated value replaces the value at the first point.
+     *
+     * \param  u               distances between points and abscissa value, i.e.\ <tt>u[i] = x[i] - x</tt>
+     * \param  v               values at points (I/O)
+     */
+    template<class T>
+    static inline void neville(const double* u, T* v)
+    {
+      for (int i = 0; i != n; ++i) {
+	if (u[i] == 0.0) {
+	  v[0] = v[i];
+	  return;
+	}
+      }
+
+      tableau<1>(u, v, JLANG::JBool<(1 < n)>());
+    }
+
+
+    /**
+     * Lagrange interpolation for equidistant points.
+     *
+     * The abscissa value is expressed in units of the distance between consecutive points,
+     * i.e.\ <tt>t[i] = (x - x[i]) / h</tt>.
+     *
+     * \param  t               distances between abscissa value and points in units of the distance between points
+     * \param  v               values at points
+     * \param  y               interpolated value
+     */
+    template<class T>
+    static inline void lagrange(const double* t, const T* v, T& y)
+    {
+      for (int i = 0; i != n; ++i) {
+	if (t[i] == 0.0) {
+	  y = v[i];
+	  return;
+	}
+      }
+
+      polynomial(t, v, y);
+    }
+
+
+    /**
+     * Get barycentric weight of given point.
+     *
+     * \param  i               index of point
+     * \return                 weight
+     */
+    static constexpr double getWeight(const int i)
+    {
+      double w = 1.0;
+
+      for (int k = 0; k != n; ++k) {
+	if (k != i) {
+	  w *= (i - k);
+	}
+      }
+
+      return 1.0 / w;
+    }
+
+  private:
+    /**
+     * Lagrange polynomial through equidistant points.
+     *
+     * \param  t               distances between abscissa value and points in units of the distance between points
+     * \param  v               values at points
+     * \param  y               interpolated value
+     */
+    template<class T>
+    static inline void polynomial(const double* t, const T* v, T& y)
+    {
+      double r[n];
+
+      suffix<n - 2>(t, r, t[n - 1], JLANG::JBool<true>());
+
+      constexpr double weight = getWeight(0);
+
+      y  = v[0];
+      y *= weight * r[0];
+
+      sum<1>(t, r, v, t[0], y, JLANG::JBool<(2 < n)>());
+    }
+
+
+    /**
+     * Column <tt>m</tt> of Neville's tableau.
+     *
+     * \param  u               distances between points and abscissa value
+     * \param  v               values (I/O)
+     * \param  option          true
+     */
+    template<int m, class T>
+    static inline void tableau(const double* u, T* v, JLANG::JBool<true> option)
+    {
+      element<m, 0>(u, v, JLANG::JBool<true>());
+
+      tableau<m + 1>(u, v, JLANG::JBool<(m + 1 < n)>());
+    }
+
+
+    /**
+     * Termination of Neville's tableau.
+     */
+    template<int m, class T>
+    static inline void tableau(const double* u, T* v, JLANG::JBool<false> option)
+    {}
+
+
+    /**
+     * Element <tt>i</tt> of column <tt>m</tt> of Neville's tableau.
+     *
+     * The value of the polynomial through points <tt>i</tt> to <tt>i + m</tt> replaces element <tt>i</tt>.
+     *
+     * \param  u               distances between points and abscissa value
+     * \param  v               values (I/O)
+     * \param  option          true
+     */
+    template<int m, int i, class T>
+    static inline void element(const double* u, T* v, JLANG::JBool<true> option)
+    {
+      const double ho = u[ i ];
+      const double hp = u[i+m];
+
+      v[i] -= v[i+1];
+      v[i] *= hp/(hp - ho);
+      v[i] += v[i+1];
+
+      element<m, i + 1>(u, v, JLANG::JBool<(i + 1 < n - m)>());
+    }
+
+
+    /**
+     * Termination of column of Neville's tableau.
+     */
+    template<int m, int i, class T>
+    static inline void element(const double* u, T* v, JLANG::JBool<false> option)
+    {}
+
+
+    /**
+     * Products of distances beyond given point, i.e.\ <tt>r[i] = t[i+1] t[i+2] ... t[n-1]</tt>.
+     *
+     * \param  t               distances
+     * \param  r               products
+     * \param  z               product of distances beyond point <tt>i</tt>
+     * \param  option          true
+     */
+    template<int i>
+    static inline void suffix(const double* t, double* r, const double z, JLANG::JBool<true> option)
+    {
+      r[i] = z;
+
+      suffix<i - 1>(t, r, z * t[i], JLANG::JBool<(i != 0)>());
+    }
+
+
+    /**
+     * Termination of products.
+     */
+    template<int i>
+    static inline void suffix(const double* t, double* r, const double z, JLANG::JBool<false> option)
+    {}
+
+
+    /**
+     * Add contribution of given point to interpolated value.
+     *
+     * \param  t               distances
+     * \param  r               products of distances beyond each point
+     * \param  v               values at points
+     * \param  z               product of distances before point <tt>i</tt>
+     * \param  y               interpolated value (I/O)
+     * \param  option          true
+     */
+    template<int i, class T>
+    static inline void sum(const double* t, const double* r, const T* v, const double z, T& y, JLANG::JBool<true> option)
+    {
+      constexpr double weight = getWeight(i);
+
+      T buffer = v[i];
+
+      buffer *= weight * z * r[i];
+
+      y += buffer;
+
+      sum<i + 1>(t, r, v, z * t[i], y, JLANG::JBool<(i + 2 < n)>());
+    }
+
+
+    /**
+     * Contribution of last point to interpolated value.
+     *
+     * \param  t               distances
+     * \param  r               products of distances beyond each point
+     * \param  v               values at points
+     * \param  z               product of distances before last point
+     * \param  y               interpolated value (I/O)
+     * \param  option          false
+     */
+    template<int i, class T>
+    static inline void sum(const double* t, const double* r, const T* v, const double z, T& y, JLANG::JBool<false> option)
+    {
+      constexpr double weight = getWeight(n - 1);
+
+      T buffer = v[n - 1];
+
+      buffer *= weight * z;
+
+      y += buffer;
+    }
+  };
+
+
   /**
    * Template definition for functional collection with polynomial interpolation.
    */
@@ -96,12 +333,38 @@ namespace JTOOLS {
      * \return                 function value
      */
     virtual result_type evaluate(const argument_type* pX) const override 
+    {
+      return evaluate(pX, this->lower_bound(*pX));
+    }
+
+
+    /**
+     * Recursive interpolation method implementation.
+     *
+     * The search of the abscissa value starts at the position held by the given cursor (see JCollection::lower_bound).
+     *
+     * \param  pX              pointer to abscissa values
+     * \param  cursor          cursor
+     * \return                 function value
+     */
+    result_type evaluate(const argument_type* pX, JCursor& cursor) const
+    {
+      return evaluate(pX, this->lower_bound(*pX, cursor));
+    }
+
+  protected:
+    /**
+     * Recursive interpolation method implementation.
+     *
+     * \param  pX              pointer to abscissa values
+     * \param  p               position of first element <tt>i</tt>, where <tt>x >= i->getX()</tt>
+     * \return                 function value
+     */
+    result_type evaluate(const argument_type* pX, const_iterator p) const
     {
       const argument_type x = *pX;
 
       if (this->size() > 1u) {
-	
-	const_iterator p = this->lower_bound(x);
 
 	if ((p == this->begin() && this->getDistance(x, (p++)->getX()) > distance_type::precision) ||
 	    (p == this->end()   && this->getDistance((--p)->getX(), x) > distance_type::precision)) {
@@ -120,6 +383,14 @@ namespace JTOOLS {
 	for (int i = n/2; i != 0 && p != this->end();   --i, ++p) {}       // move p to begin of data
 	for (int i = n  ; i != 0 && p != this->begin(); --i, --p) {}
 
+	if (n == N + 1) {
+	  return interpolate(x, pX, p, JLANG::JBool<std::is_base_of<JGridCollection<JElement_t, JDistance_t>, collection_type>::value>());
+	}
+
+
+	double      u[N+1];
+	result_type v[N+1] = {};
+	result_type w[N+1];
 
 	int j = 0;
 
@@ -173,18 +444,74 @@ namespace JTOOLS {
       }
     }
 
-  protected: 
+
     /**
-     * Function compilation.
+     * Polynomial interpolation with <tt>N + 1</tt> points.
+     *
+     * \param  x               abscissa value
+     * \param  pX              pointer to next abscissa values
+     * \param  p               position of first point
+     * \param  option          false
+     * \return                 function value
      */
-    virtual void do_compile() override 
-    {}
+    result_type interpolate(const argument_type x, const argument_type* pX, const_iterator p, JLANG::JBool<false> option) const
+    {
+      double      u[N+1];
+      result_type v[N+1];
 
+      for (int i = 0; i != N + 1; ++p, ++i) {
+	
+	u[i] = this->getDistance(x, p->getX());
+	v[i] = function_type::getValue(p->getY(), pX);
+      }
 
-  private: 
-    mutable double      u[N+1];
-    mutable result_type v[N+1];
-    mutable result_type w[N+1];
+      JPolintKernel<N + 1>::neville(u, v);
+
+      return v[0];
+    }
+
+
+    /**
+     * Polynomial interpolation with <tt>N + 1</tt> equidistant points.
+     *
+     * The Lagrange form is used (see JPolintKernel::lagrange).
+     * The result hence differs by rounding from that of the same points in a non-equidistant collection,
+     * except at the points themselves, where the values are reproduced exactly.
+     *
+     * \param  x               abscissa value
+     * \param  pX              pointer to next abscissa values
+     * \param  p               position of first point
+     * \param  option          true
+     * \return                 function value
+     */
+    result_type interpolate(const argument_type x, const argument_type* pX, const_iterator p, JLANG::JBool<true> option) const
+    {
+      const double f = (this->size() - 1) / this->getDistance(this->begin()->getX(), this->rbegin()->getX());
+
+      double      t[N+1];
+      result_type v[N+1];
+
+      for (int i = 0; i != N + 1; ++p, ++i) {
+
+	t[i] = this->getDistance(p->getX(), x) * f;
+	v[i] = function_type::getValue(p->getY(), pX);
+      }
+
+      result_type y;
+
+      JPolintKernel<N + 1>::lagrange(t, v, y);
+
+      return y;
+    }
+
+
+    /**
+     * Function compilation.
+     */
+    virtual void do_compile() override 
+    {
+      this->updateIndex();
+    }
   };
 
 
@@ -238,12 +565,38 @@ namespace JTOOLS {
      * \return                 function value
      */
     virtual result_type evaluate(const argument_type* pX) const override 
+    {
+      return evaluate(pX, this->lower_bound(*pX));
+    }
+
+
+    /**
+     * Recursive interpolation method implementation.
+     *
+     * The search of the abscissa value starts at the position held by the given cursor (see JCollection::lower_bound).
+     *
+     * \param  pX              pointer to abscissa values
+     * \param  cursor          cursor
+     * \return                 function value
+     */
+    result_type evaluate(const argument_type* pX, JCursor& cursor) const
+    {
+      return evaluate(pX, this->lower_bound(*pX, cursor));
+    }
+
+  protected:
+    /**
+     * Recursive interpolation method implementation.
+     *
+     * \param  pX              pointer to abscissa values
+     * \param  p               position of first element <tt>i</tt>, where <tt>x >= i->getX()</tt>
+     * \return                 function value
+     */
+    result_type evaluate(const argument_type* pX, const_iterator p) const
     {
       const argument_type x = *pX;
 
       if (this->size() > 1u) {
-	
-	const_iterator p = this->lower_bound(x);
 
 	if ((p == this->begin() && this->getDistance(x, (p++)->getX()) > distance_type::precision) ||
 	    (p == this->end()   && this->getDistance((--p)->getX(), x) > distance_type::precision)) {
@@ -274,12 +627,14 @@ namespace JTOOLS {
       }
     }
 
-  protected:
+
     /**
      * Function compilation.
      */
     virtual void do_compile() override 
-    {}
+    {
+      this->updateIndex();
+    }
   };
 
 
@@ -333,13 +688,39 @@ namespace JTOOLS {
      * \return                 function value
      */
     virtual result_type evaluate(const argument_type* pX) const override 
+    {
+      return evaluate(pX, this->lower_bound(*pX));
+    }
+
+
+    /**
+     * Recursive interpolation method implementation.
+     *
+     * The search of the abscissa value starts at the position held by the given cursor (see JCollection::lower_bound).
+     *
+     * \param  pX              pointer to abscissa values
+     * \param  cursor          cursor
+     * \return                 function value
+     */
+    result_type evaluate(const argument_type* pX, JCursor& cursor) const
+    {
+      return evaluate(pX, this->lower_bound(*pX, cursor));
+    }
+
+  protected:
+    /**
+     * Recursive interpolation method implementation.
+     *
+     * \param  pX              pointer to abscissa values
+     * \param  p               position of first element <tt>i</tt>, where <tt>x >= i->getX()</tt>
+     * \return                 function value
+     */
+    result_type evaluate(const argument_type* pX, const_iterator p) const
     {
       const argument_type x = *pX;
 
       if (this->size() > 1u) {
 
-	const_iterator p = this->lower_bound(x);
-
 	if ((p == this->begin() && this->getDistance(x, (p++)->getX()) > distance_type::precision) ||
 	    (p == this->end()   && this->getDistance((--p)->getX(), x) > distance_type::precision)) {
 
@@ -358,8 +739,8 @@ namespace JTOOLS {
 	const double a  = this->getDistance(x, q->getX()) / dx;
 	const double b  = 1.0 - a;
 
-	ya = function_type::getValue(p->getY(), pX);
-	yb = function_type::getValue(q->getY(), pX);
+	result_type ya = function_type::getValue(p->getY(), pX);
+	result_type yb = function_type::getValue(q->getY(), pX);
 
 	ya *= a;
 	yb *= b;
@@ -378,17 +759,14 @@ namespace JTOOLS {
       }
     }
 
-  protected:
+
     /**
      * Function compilation.
      */
     virtual void do_compile() override 
-    {}
-
-
-  private:
-    mutable result_type ya;
-    mutable result_type yb;
+    {
+      this->updateIndex();
+    }
   };
 
 
@@ -450,6 +828,34 @@ namespace JTOOLS {
      * \return                 function value
      */
     virtual result_type evaluate(const argument_type* pX) const override 
+    {
+      return evaluate(pX, this->lower_bound(*pX));
+    }
+
+
+    /**
+     * Recursive interpolation method implementation.
+     *
+     * The search of the abscissa value starts at the position held by the given cursor (see JCollection::lower_bound).
+     *
+     * \param  pX              pointer to abscissa values
+     * \param  cursor          cursor
+     * \return                 function value
+     */
+    result_type evaluate(const argument_type* pX, JCursor& cursor) const
+    {
+      return evaluate(pX, this->lower_bound(*pX, cursor));
+    }
+
+  protected:
+    /**
+     * Recursive interpolation method implementation.
+     *
+     * \param  pX              pointer to abscissa values
+     * \param  p               position of first element <tt>i</tt>, where <tt>x >= i->getX()</tt>
+     * \return                 function value
+     */
+    result_type evaluate(const argument_type* pX, const_iterator p) const
     {
       const argument_type x = *pX;
 
@@ -457,7 +863,7 @@ namespace JTOOLS {
         return this->getExceptionHandler().action(MAKE_EXCEPTION(JFunctionalException, "not enough data " << STREAM("?") << x));
       }
 
-      const_iterator p = this->lower_bound(x);
+      result_type result;
 
       if        (p == this->begin() && this->getDistance(x, (p++)->getX()) > distance_type::precision) {
 
@@ -504,6 +910,10 @@ namespace JTOOLS {
 	for (int i = n/2; i != 0 && p != this->end();   --i, ++p) {}       // move p to begin of data
 	for (int i = n  ; i != 0 && p != this->begin(); --i, --p) {}
 
+	double    u[N+1];
+	data_type v[N+1][3];
+	data_type w[N+1][3];
+	data_type r[3];
 	
 	int j = 0;
 	
@@ -568,12 +978,14 @@ namespace JTOOLS {
       return result;
     }
 
-  protected: 
+
     /**
      * Function compilation.
      */
     virtual void do_compile() override 
     {
+      this->updateIndex();
+
       ordinate_type V(JMATH::zero);
 
       if (this->getSize() > 1) {
@@ -599,14 +1011,6 @@ namespace JTOOLS {
 	}
       }
     }
-
-
-    mutable double    u[N+1];
-    mutable data_type v[N+1][3];
-    mutable data_type w[N+1][3];
-    mutable data_type r[3];
-
-    mutable result_type result;
   };
 
 
@@ -673,6 +1077,34 @@ namespace JTOOLS {
      * \return                 function value
      */
     result_type evaluate(const argument_type* pX) const
+    {
+      return evaluate(pX, this->lower_bound(*pX));
+    }
+
+
+    /**
+     * Recursive interpolation method implementation.
+     *
+     * The search of the abscissa value starts at the position held by the given cursor (see JCollection::lower_bound).
+     *
+     * \param  pX              pointer to abscissa values
+     * \param  cursor          cursor
+     * \return                 function value
+     */
+    result_type evaluate(const argument_type* pX, JCursor& cursor) const
+    {
+      return evaluate(pX, this->lower_bound(*pX, cursor));
+    }
+
+  protected:
+    /**
+     * Recursive interpolation method implementation.
+     *
+     * \param  pX              pointer to abscissa values
+     * \param  p               position of first element <tt>i</tt>, where <tt>x >= i->getX()</tt>
+     * \return                 function value
+     */
+    result_type evaluate(const argument_type* pX, const_iterator p) const
     {
       const argument_type x = *pX;
 
@@ -680,8 +1112,6 @@ namespace JTOOLS {
         THROW(JFunctionalException, "not enough data " << STREAM("?") << x);
       }
 
-      const_iterator p = this->lower_bound(x);
-
       if ((p == this->begin() && this->getDistance(x, (p++)->getX()) > distance_type::precision) ||
           (p == this->end()   && this->getDistance((--p)->getX(), x) > distance_type::precision)) {
 
@@ -700,6 +1130,13 @@ namespace JTOOLS {
       for (int i = n  ; i != 0 && p != this->begin(); --i, --p) {}
 
 
+      double      u[N+1];
+      data_type   v[N+1][M+1];
+      data_type   w[N+1][M+1];
+      data_type   r[M+1];
+
+      result_type result;
+
       int j = 0;
 
       for (int i = 0; i != n; ++p, ++i) {
@@ -764,21 +1201,14 @@ namespace JTOOLS {
       return result;
     }
 
-  protected: 
+
     /**
      * Function compilation.
      */
     virtual void do_compile() override 
-    {}
-
-
-  private: 
-    mutable double    u[N+1];
-    mutable data_type v[N+1][M+1];
-    mutable data_type w[N+1][M+1];
-    mutable data_type r[M+1];
-
-    mutable result_type result;
+    {
+      this->updateIndex();
+    }
   };
 
 
@@ -847,6 +1277,26 @@ namespace JTOOLS {
         return this->getExceptionHandler().action(error);
       }
     }
+
+
+    /**
+     * Recursive interpolation method implementation.
+     *
+     * The search of the abscissa value starts at the position held by the given cursor (see JCollection::lower_bound).
+     *
+     * \param  pX              pointer to abscissa values
+     * \param  cursor          cursor
+     * \return                 function value
+     */
+    result_type evaluate(const argument_type* pX, JCursor& cursor) const
+    {
+      try {
+	return collection_type::evaluate(pX, cursor);
+      }
+      catch(const JException& error) {
+        return this->getExceptionHandler().action(error);
+      }
+    }
   };
 
 
@@ -917,6 +1367,26 @@ namespace JTOOLS {
         return this->getExceptionHandler().action(error);
       }
     }
+
+
+    /**
+     * Recursive interpolation method implementation.
+     *
+     * The search of the abscissa value starts at the position held by the given cursor (see JCollection::lower_bound).
+     *
+     * \param  pX              pointer to abscissa values
+     * \param  cursor          cursor
+     * \return                 function value
+     */
+    result_type evaluate(const argument_type* pX, JCursor& cursor) const
+    {
+      try {
+	return collection_type::evaluate(pX, cursor);
+      }
+      catch(const JException& error) {
+        return this->getExceptionHandler().action(error);
+      }
+    }
   };
 
 
@@ -987,6 +1457,26 @@ namespace JTOOLS {
         return this->getExceptionHandler().action(error);
       }
     }
+
+
+    /**
+     * Recursive interpolation method implementation.
+     *
+     * The search of the abscissa value starts at the position held by the given cursor (see JCollection::lower_bound).
+     *
+     * \param  pX              pointer to abscissa values
+     * \param  cursor          cursor
+     * \return                 function value
+     */
+    result_type evaluate(const argument_type* pX, JCursor& cursor) const
+    {
+      try {
+	return collection_type::evaluate(pX, cursor);
+      }
+      catch(const JException& error) {
+        return this->getExceptionHandler().action(error);
+      }
+    }
   };
 
 
@@ -1030,6 +1520,24 @@ namespace JTOOLS {
      */
     JPolintFunction1D()
     {}
+
+
+    using function_type::operator();
+
+
+    /**
+     * Function value evaluation.
+     *
+     * The search of the abscissa value starts at the position held by the given cursor (see JCollection::lower_bound).
+     *
+     * \param  x               argument value
+     * \param  cursor          cursor
+     * \return                 function value
+     */
+    result_type operator()(const argument_type x, JCursor& cursor) const
+    {
+      return this->evaluate(&x, cursor);
+    }
   };
 
 
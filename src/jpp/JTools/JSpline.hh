@@ -2,6 +2,10 @@
 #define __JTOOLS__JSPLINE__
 
 #include <utility>
+#include <vector>
+#include <iterator>
+#include <cmath>
+#include <type_traits>
 
 #include "JMath/JZero.hh"
 #include "JLang/JException.hh"
@@ -199,6 +203,8 @@ namespace JTOOLS {
      */
     void compile(const JSplineBounds<ordinate_type>& bounds) 
     {
+      this->updateIndex();
+
       const int numberOfElements = this->size();
 
       using namespace std;
@@ -364,13 +370,39 @@ namespace JTOOLS {
      * \return                 function value
      */
     virtual result_type evaluate(const argument_type* pX) const override 
+    {
+      return evaluate(pX, this->lower_bound(*pX));
+    }
+
+
+    /**
+     * Recursive interpolation method implementation.
+     *
+     * The search of the abscissa value starts at the position held by the given cursor (see JCollection::lower_bound).
+     *
+     * \param  pX              pointer to abscissa values
+     * \param  cursor          cursor
+     * \return                 function value
+     */
+    result_type evaluate(const argument_type* pX, JCursor& cursor) const
+    {
+      return evaluate(pX, this->lower_bound(*pX, cursor));
+    }
+
+  protected:
+    /**
+     * Recursive interpolation method implementation.
+     *
+     * \param  pX              pointer to abscissa values
+     * \param  p               position of first element <tt>i</tt>, where <tt>x >= i->getX()</tt>
+     * \return                 function value
+     */
+    result_type evaluate(const argument_type* pX, const_iterator p) const
     {
       const argument_type x = *pX;
 
       if (this->size() > 1u) {
 
-	const_iterator p = this->lower_bound(x);
-
 	if ((p == this->begin() && this->getDistance(x, (p++)->getX()) > distance_type::precision) ||
 	    (p == this->end()   && this->getDistance((--p)->getX(), x) > distance_type::precision)) {
 
@@ -451,6 +483,34 @@ namespace JTOOLS {
      * \return                 function value
      */
     virtual result_type evaluate(const argument_type* pX) const override 
+    {
+      return evaluate(pX, this->lower_bound(*pX));
+    }
+
+
+    /**
+     * Recursive interpolation method implementation.
+     *
+     * The search of the abscissa value starts at the position held by the given cursor (see JCollection::lower_bound).
+     *
+     * \param  pX              pointer to abscissa values
+     * \param  cursor          cursor
+     * \return                 function value
+     */
+    result_type evaluate(const argument_type* pX, JCursor& cursor) const
+    {
+      return evaluate(pX, this->lower_bound(*pX, cursor));
+    }
+
+  protected:
+    /**
+     * Recursive interpolation method implementation.
+     *
+     * \param  pX              pointer to abscissa values
+     * \param  p               position of first element <tt>i</tt>, where <tt>x >= i->getX()</tt>
+     * \return                 function value
+     */
+    result_type evaluate(const argument_type* pX, const_iterator p) const
     {
       const argument_type x = *pX;
 
@@ -458,8 +518,6 @@ namespace JTOOLS {
         return this->getExceptionHandler().action(MAKE_EXCEPTION(JFunctionalException, "not enough data " << STREAM("?") << x));
       }
 
-      const_iterator p = this->lower_bound(x);
-
 
       if ((p == this->begin() && this->getDistance(x, (p++)->getX()) > distance_type::precision) ||
           (p == this->end()   && this->getDistance((--p)->getX(), x) > distance_type::precision)) {
@@ -476,6 +534,8 @@ namespace JTOOLS {
       const double a  = this->getDistance(x, q->getX()) / dx;
       const double b  = 1.0 - a;
 
+      result_type result;
+
       result.f   = a * p->getY() + b * q->getY()
 	- a*b * ((a + 1.0)*p->getU() + (b + 1.0)*q->getU()) * dx*dx/6;
 
@@ -484,10 +544,6 @@ namespace JTOOLS {
 
       return result;
     }
-
-
-  private:
-    mutable result_type result;
   };
 
 
@@ -576,6 +632,34 @@ namespace JTOOLS {
      * \return                 function value
      */
     virtual result_type evaluate(const argument_type* pX) const override 
+    {
+      return evaluate(pX, this->lower_bound(*pX));
+    }
+
+
+    /**
+     * Recursive interpolation method implementation.
+     *
+     * The search of the abscissa value starts at the position held by the given cursor (see JCollection::lower_bound).
+     *
+     * \param  pX              pointer to abscissa values
+     * \param  cursor          cursor
+     * \return                 function value
+     */
+    result_type evaluate(const argument_type* pX, JCursor& cursor) const
+    {
+      return evaluate(pX, this->lower_bound(*pX, cursor));
+    }
+
+  protected:
+    /**
+     * Recursive interpolation method implementation.
+     *
+     * \param  pX              pointer to abscissa values
+     * \param  p               position of first element <tt>i</tt>, where <tt>x >= i->getX()</tt>
+     * \return                 function value
+     */
+    result_type evaluate(const argument_type* pX, const_iterator p) const
     {
       const argument_type x = *pX;
 
@@ -583,7 +667,7 @@ namespace JTOOLS {
         return this->getExceptionHandler().action(MAKE_EXCEPTION(JFunctionalException, "not enough data " << STREAM("?") << x));
       }
 
-      const_iterator p = this->lower_bound(x);
+      result_type result;
 
       if        (p == this->begin() && this->getDistance(x, (p++)->getX()) > distance_type::precision) {
 
@@ -646,7 +730,6 @@ namespace JTOOLS {
     }
 
 
-  protected:
     /**
      * Determination of second derivatives with no bounds.
      */
@@ -654,10 +737,6 @@ namespace JTOOLS {
     {
       compile(JSplineBounds<ordinate_type>());
     }
-
-
-  private:
-    mutable result_type result;
   };
 
 
@@ -700,6 +779,24 @@ namespace JTOOLS {
      */
     JSplineFunction1D()
     {}
+
+
+    using function_type::operator();
+
+
+    /**
+     * Function value evaluation.
+     *
+     * The search of the abscissa value starts at the position held by the given cursor (see JCollection::lower_bound).
+     *
+     * \param  x               argument value
+     * \param  cursor          cursor
+     * \return                 function value
+     */
+    result_type operator()(const argument_type x, JCursor& cursor) const
+    {
+      return this->evaluate(&x, cursor);
+    }
   };
 
 
@@ -717,6 +814,14 @@ namespace JTOOLS {
 
   /**
    * Functional map with spline interpolation.
+   *
+   * If the result type is equal to the data type and all values of the map are defined on the same grid,
+   * the second derivatives of the values along the abscissa of this map are determined at compilation.\n
+   * These second derivatives are stored as functions of the remaining abscissa values (i.e.\ a tensor-product spline),
+   * so that the evaluation only involves the values and second derivatives at the two nearest nodes.\n
+   * Otherwise, the values at all nodes are evaluated and a one-dimensional spline is compiled at each evaluation.\n
+   * This one-dimensional spline is held per thread (see JSplineMap::getBuffer), so that the evaluation is thread safe
+   * and its memory is only allocated when the number of elements increases.
    */
   template<class JKey_t,
            class JValue_t,
@@ -767,14 +872,225 @@ namespace JTOOLS {
      */
     virtual result_type evaluate(const argument_type* pX) const override 
     {
+      return interpolate(pX, std::integral_constant<bool, std::is_same<result_type, data_type>::value>());
+    }
+
+
+    /**
+     * Recursive interpolation method implementation.
+     *
+     * The search of the abscissa value starts at the position held by the given cursor (see JCollection::lower_bound).\n
+     * The cursor is only used if the second derivatives have been determined at compilation.
+     *
+     * \param  pX              pointer to abscissa values
+     * \param  cursor          cursor
+     * \return                 function value
+     */
+    result_type evaluate(const argument_type* pX, JCursor& cursor) const
+    {
+      return interpolate(pX, cursor, std::integral_constant<bool, std::is_same<result_type, data_type>::value>());
+    }
+
+
+  private:
+    /**
+     * Function compilation.
+     *
+     * The second derivatives of the values along the abscissa of this map are determined
+     * using the same algorithm as JSplineCollection::compile with no bounds.\n
+     * The second derivatives are zero for abscissa values of the functions which are out of range,
+     * so that the result follows the exception handler of these functions.
+     */
+    virtual void do_compile() override 
+    {
+      using namespace std;
+
+      this->updateIndex();
+
+      U.clear();
+
+      const int numberOfElements = this->size();
+
+      if (!is_same<result_type, data_type>::value || numberOfElements < 2) {
+	return;
+      }
+
+      for (const_iterator i = this->begin(), j = i++; i != this->end(); ++i) {
+	if (!hasSameGrid(j->getY(), i->getY(), 0)) {
+	  return;
+	}
+      }
+
+      vector<double> buffer(numberOfElements, 0.0);
+
+      U.resize(numberOfElements, this->begin()->getY());
+
+      mul(U[0], 0.0, 0);
+
+      int index = 1;
+
+      for (const_iterator k = this->begin(), i = k++, j = k++; k != this->end(); ++i, ++j, ++k, ++index) {
+
+	const double d12 = this->getDistance(i->getX(), j->getX());
+	const double d13 = this->getDistance(i->getX(), k->getX());
+	const double d23 = this->getDistance(j->getX(), k->getX());
+
+	const double sig = d12 / d13;
+	const double h   = sig * buffer[index-1] + 2.0;
+
+	buffer[index] = (sig - 1.0) / h;
+
+	JValue_t& u = U[index];
+
+	u = k->getY();
+
+	add(u, j->getY(), -1.0, 0);
+	mul(u, 1.0 / d23, 0);
+	add(u, j->getY(), -1.0 / d12, 0);
+	add(u, i->getY(), +1.0 / d12, 0);
+	mul(u, 6.0 / d13, 0);
+	add(u, U[index-1], -sig, 0);
+	mul(u, 1.0 / h, 0);
+      }
+
+      mul(U[numberOfElements - 1], 0.0, 0);
+
+      for (index = numberOfElements - 2; index >= 0; --index) {
+	add(U[index], U[index+1], buffer[index], 0);
+      }
+
+      const typename JValue_t::supervisor_type supervisor(new typename JValue_t::JDefaultResult(JMATH::zero));
+
+      for (typename vector<JValue_t>::iterator i = U.begin(); i != U.end(); ++i) {
+	compileAll(*i, 0);
+	setExceptionHandlerAll(*i, supervisor, 0);
+      }
+    }
+
+
+    /**
+     * Interpolation using second derivatives determined at compilation.
+     *
+     * \param  pX              pointer to abscissa values
+     * \param  option          true
+     * \return                 function value
+     */
+    result_type interpolate(const argument_type* pX, std::true_type option) const
+    {
+      if (U.size() != this->size()) {
+	return interpolate(pX, std::false_type());
+      }
+
+      return interpolate(pX, this->lower_bound(*pX));
+    }
+
+
+    /**
+     * Interpolation using second derivatives determined at compilation.
+     *
+     * \param  pX              pointer to abscissa values
+     * \param  cursor          cursor
+     * \param  option          true
+     * \return                 function value
+     */
+    result_type interpolate(const argument_type* pX, JCursor& cursor, std::true_type option) const
+    {
+      if (U.size() != this->size()) {
+	return interpolate(pX, std::false_type());
+      }
+
+      return interpolate(pX, this->lower_bound(*pX, cursor));
+    }
+
+
+    /**
+     * Interpolation using one-dimensional spline compiled at each evaluation.
+     *
+     * \param  pX              pointer to abscissa values
+     * \param  cursor          cursor
+     * \param  option          false
+     * \return                 function value
+     */
+    result_type interpolate(const argument_type* pX, JCursor& cursor, std::false_type option) const
+    {
+      return interpolate(pX, std::false_type());
+    }
+
+
+    /**
+     * Interpolation using second derivatives determined at compilation.
+     *
+     * \param  pX              pointer to abscissa values
+     * \param  p               position of first element <tt>i</tt>, where <tt>x >= i->getX()</tt>
+     * \return                 function value
+     */
+    result_type interpolate(const argument_type* pX, const_iterator p) const
+    {
+      const argument_type x = *pX;
+
+      ++pX;  // next argument value
+
+      if ((p == this->begin() && this->getDistance(x, (p++)->getX()) > distance_type::precision) ||
+	  (p == this->end()   && this->getDistance((--p)->getX(), x) > distance_type::precision)) {
+
+	return this->getExceptionHandler().action(MAKE_EXCEPTION(JValueOutOfRange, "abscissa out of range " 
+								 << STREAM("?") << x                      << " <> " 
+								 << STREAM("?") << this->begin() ->getX() << ' '
+								 << STREAM("?") << this->rbegin()->getX()));
+      }
+
+      const_iterator q = p--;
+
+      const size_t index = std::distance(this->begin(), p);
+
+      const double dx = this->getDistance(p->getX(), q->getX());
+      const double a  = this->getDistance(x, q->getX()) / dx;
+      const double b  = 1.0 - a;
+
+      const data_type yp = JFunction<argument_type, data_type>::getValue(p->getY(),  pX);
+      const data_type yq = JFunction<argument_type, data_type>::getValue(q->getY(),  pX);
+      const data_type up = JFunction<argument_type, data_type>::getValue(U[index],   pX);
+      const data_type uq = JFunction<argument_type, data_type>::getValue(U[index+1], pX);
+
+      return (a * yp + b * yq
+	      - a*b * ((a + 1.0)*up + (b + 1.0)*uq) * dx*dx/6);
+    }
+
+
+    /**
+     * Get one-dimensional spline for the interpolation without second derivatives.
+     *
+     * The one-dimensional spline is held per thread.
+     *
+     * \return                 one-dimensional spline
+     */
+    static JSplineFunction1D_t& getBuffer()
+    {
+      static thread_local JSplineFunction1D_t buffer;
+
+      return buffer;
+    }
+
+
+    /**
+     * Interpolation using one-dimensional spline compiled at each evaluation.
+     *
+     * \param  pX              pointer to abscissa values
+     * \param  option          false
+     * \return                 function value
+     */
+    result_type interpolate(const argument_type* pX, std::false_type option) const
+    {
+      JSplineFunction1D_t& buffer = getBuffer();
+
       const argument_type x = *pX;
 
       ++pX;  // next argument value
 
-      const_iterator p = this->begin();
+      buffer.clear();
 
-      for (typename JSplineFunction1D_t::iterator q = buffer.begin(); q != buffer.end(); ++q, ++p) {
-	q->getY() = JFunction<argument_type, data_type>::getValue(p->getY(), pX);
+      for (const_iterator p = this->begin(); p != this->end(); ++p) {
+	buffer.put(p->getX(), JFunction<argument_type, data_type>::getValue(p->getY(), pX));
       }
 
       buffer.compile();
@@ -783,21 +1099,177 @@ namespace JTOOLS {
     }
 
 
-  private:
     /**
-     * Function compilation.
+     * Check whether given collections are defined on the same grid.
+     *
+     * The check is recursively applied to the values of the collections.
+     *
+     * \param  first           first  collection
+     * \param  second          second collection
+     * \param  option          overload selection for collection
+     * \return                 true if same grid; else false
      */
-    virtual void do_compile() override 
+    template<class T>
+    static auto hasSameGrid(const T& first, const T& second, int option) -> decltype(first.begin()->getX(), bool())
     {
-      buffer.clear();
+      if (first.size() != second.size()) {
+	return false;
+      }
 
-      for (iterator i = this->begin(); i != this->end(); ++i) {
-	buffer.put(i->getX(), data_type());
+      for (auto i = first.begin(), j = second.begin(); i != first.end(); ++i, ++j) {
+	if (std::fabs(first.getDistance(i->getX(), j->getX())) > T::distance_type::precision || !hasSameGrid(i->getY(), j->getY(), 0)) {
+	  return false;
+	}
+      }
+
+      return true;
+    }
+
+
+    /**
+     * Termination of recursive check of grid.
+     *
+     * \param  first           first  value
+     * \param  second          second value
+     * \param  option          overload selection for other data type
+     * \return                 true
+     */
+    template<class T>
+    static bool hasSameGrid(const T& first, const T& second, long option)
+    {
+      return true;
+    }
+
+
+    /**
+     * Add scaled values of given collection to values of other collection.
+     *
+     * The collections should be defined on the same grid (see method hasSameGrid).
+     *
+     * \param  output          output collection
+     * \param  input           input  collection
+     * \param  factor          multiplication factor
+     * \param  option          overload selection for collection
+     */
+    template<class T>
+    static auto add(T& output, const T& input, const double factor, int option) -> decltype(output.begin()->getY(), void())
+    {
+      auto j = input.begin();
+
+      for (auto i = output.begin(); i != output.end(); ++i, ++j) {
+	add(i->getY(), j->getY(), factor, 0);
       }
     }
 
 
-    mutable JSplineFunction1D_t buffer;
+    /**
+     * Add scaled value to other value.
+     *
+     * \param  output          output value
+     * \param  input           input  value
+     * \param  factor          multiplication factor
+     * \param  option          overload selection for other data type
+     */
+    template<class T>
+    static void add(T& output, const T& input, const double factor, long option)
+    {
+      output += input * factor;
+    }
+
+
+    /**
+     * Scale values of given collection.
+     *
+     * \param  output          collection
+     * \param  factor          multiplication factor
+     * \param  option          overload selection for collection
+     */
+    template<class T>
+    static auto mul(T& output, const double factor, int option) -> decltype(output.begin()->getY(), void())
+    {
+      for (auto i = output.begin(); i != output.end(); ++i) {
+	mul(i->getY(), factor, 0);
+      }
+    }
+
+
+    /**
+     * Scale value.
+     *
+     * \param  output          value
+     * \param  factor          multiplication factor
+     * \param  option          overload selection for other data type
+     */
+    template<class T>
+    static void mul(T& output, const double factor, long option)
+    {
+      output *= factor;
+    }
+
+
+    /**
+     * Compile given function and recursively the functions of its values.
+     *
+     * \param  function        function
+     * \param  option          overload selection for collection of functions
+     */
+    template<class T>
+    static auto compileAll(T& function, int option) -> decltype(function.begin()->getY().compile(), void())
+    {
+      for (auto i = function.begin(); i != function.end(); ++i) {
+	compileAll(i->getY(), 0);
+      }
+
+      function.compile();
+    }
+
+
+    /**
+     * Compile given function.
+     *
+     * \param  function        function
+     * \param  option          overload selection for other function
+     */
+    template<class T>
+    static void compileAll(T& function, long option)
+    {
+      function.compile();
+    }
+
+
+    /**
+     * Set supervisor of given function and recursively of the functions of its values.
+     *
+     * \param  function        function
+     * \param  supervisor      supervisor
+     * \param  option          overload selection for collection of functions
+     */
+    template<class T>
+    static auto setExceptionHandlerAll(T& function, const typename T::supervisor_type& supervisor, int option) -> decltype(function.begin()->getY().setExceptionHandler(supervisor), void())
+    {
+      for (auto i = function.begin(); i != function.end(); ++i) {
+	setExceptionHandlerAll(i->getY(), supervisor, 0);
+      }
+
+      function.setExceptionHandler(supervisor);
+    }
+
+
+    /**
+     * Set supervisor of given function.
+     *
+     * \param  function        function
+     * \param  supervisor      supervisor
+     * \param  option          overload selection for other function
+     */
+    template<class T>
+    static void setExceptionHandlerAll(T& function, const typename T::supervisor_type& supervisor, long option)
+    {
+      function.setExceptionHandler(supervisor);
+    }
+
+
+    std::vector<JValue_t> U;      //!< second derivatives of values
   };
 
 
@@ -189,7 +189,9 @@ namespace JTOOLS {
     template<class ...Args>
     result_type operator()(const Args& ...args) const
     {
-      return this->evaluate(this->buffer.set(args...).data());
+      const JArray<NUMBER_OF_DIMENSIONS, argument_type> buffer(args...);
+
+      return this->evaluate(buffer.data());
     }
 
 
@@ -201,16 +203,14 @@ namespace JTOOLS {
      */
     virtual result_type evaluate(const argument_type* pX) const override 
     {
-      for (int i = 0; i != NUMBER_OF_DIMENSIONS; ++i) {
-        this->buffer[i] = pX[i];
-      }
+      JArray<NUMBER_OF_DIMENSIONS, argument_type> buffer(pX);
 
-      this->buffer[NUMBER_OF_DIMENSIONS - 1] = transformer->putXn(this->buffer, this->buffer[NUMBER_OF_DIMENSIONS - 1]);
+      buffer[NUMBER_OF_DIMENSIONS - 1] = transformer->putXn(buffer, buffer[NUMBER_OF_DIMENSIONS - 1]);
 
-      const result_type y = multifunction_type::evaluate(this->buffer.data());
-      const double      W = transformer->getWeight(this->buffer);
+      const result_type y = multifunction_type::evaluate(buffer.data());
+      const double      W = transformer->getWeight(buffer);
 
-      return JResultTransformer<result_type>::transform(*transformer, this->buffer, y) * W;      
+      return JResultTransformer<result_type>::transform(*transformer, buffer, y) * W;      
     }
 
 
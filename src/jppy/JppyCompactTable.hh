@@ -0,0 +1,938 @@
+#ifndef __JPHYSICS__JPPYCOMPACTTABLE__
+#define __JPHYSICS__JPPYCOMPACTTABLE__
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <type_traits>
+
+#include "JTools/JArray.hh"
+#include "JTools/JMapList.hh"
+#include "JTools/JFunctional.hh"
+#include "JTools/JFunctionalMap_t.hh"
+#include "JTools/JConstantFunction1D.hh"
+#include "JTools/JSpline.hh"
+#include "JTools/JCollection.hh"
+#include "JTools/JDistance.hh"
+#include "JTools/JResult.hh"
+#include "JTools/JResultTransformer.hh"
+#include "JLang/JSharedPointer.hh"
+#include "JLang/JException.hh"
+#include "JPhysics/JPDFTable.hh"
+#include "JPhysics/JNPETable.hh"
+
+
+/**
+ * \file
+ *
+ * Compacted read-only representations of PDF and NPE tables.
+ */
+
+namespace JPHYSICS {}
+namespace JPP { using namespace JPHYSICS; }
+
+namespace JPHYSICS {
+
+  using JLANG::JValueOutOfRange;
+  using JLANG::JFunctionalException;
+
+
+  /**
+   * Auxiliary data structure for the interpolation method of a functional map in a compacted table.
+   *
+   * Only maps with polynomial interpolation are supported.
+   */
+  template<template<class, class, class> class JMap_t>
+  struct JppyCompactMap;
+
+
+#define JPPY_COMPACT_MAP(JMAP_T, DEGREE, GRID)	\
+  template<>					\
+  struct JppyCompactMap<JTOOLS::JMAP_T> {	\
+    enum { degree = DEGREE, grid = GRID };	\
+  };
+
+  JPPY_COMPACT_MAP(JPolint0FunctionalMap,     0, false)
+  JPPY_COMPACT_MAP(JPolint1FunctionalMap,     1, false)
+  JPPY_COMPACT_MAP(JPolint2FunctionalMap,     2, false)
+  JPPY_COMPACT_MAP(JPolint3FunctionalMap,     3, false)
+  JPPY_COMPACT_MAP(JPolint0FunctionalGridMap, 0, true)
+  JPPY_COMPACT_MAP(JPolint1FunctionalGridMap, 1, true)
+  JPPY_COMPACT_MAP(JPolint2FunctionalGridMap, 2, true)
+  JPPY_COMPACT_MAP(JPolint3FunctionalGridMap, 3, true)
+  JPPY_COMPACT_MAP(JPolint0FunctionalLookupMap, 0, false)
+  JPPY_COMPACT_MAP(JPolint1FunctionalLookupMap, 1, false)
+  JPPY_COMPACT_MAP(JPolint2FunctionalLookupMap, 2, false)
+  JPPY_COMPACT_MAP(JPolint3FunctionalLookupMap, 3, false)
+
+#undef JPPY_COMPACT_MAP
+
+
+  /**
+   * Get interpolation methods of given map list.
+   *
+   * Termination of recursion.
+   */
+  inline void getCompactMaps(int*, bool*, const JLANG::JNullType*)
+  {}
+
+
+  /**
+   * Get interpolation methods of given map list.
+   *
+   * \param  degree             pointer to output degree of polynomial
+   * \param  grid               pointer to output grid option
+   * \param  maplist            map list
+   */
+  template<template<class, class, class> class JHead_t, class JTail_t>
+  inline void getCompactMaps(int* degree, bool* grid, const JTOOLS::JMapList<JHead_t, JTail_t>*)
+  {
+    *degree = JppyCompactMap<JHead_t>::degree;
+    *grid   = JppyCompactMap<JHead_t>::grid;
+
+    getCompactMaps(++degree, ++grid, (JTail_t*) NULL);
+  }
+
+
+  /**
+   * Get position of first abscissa value, where <tt>x >= value</tt>.
+   *
+   * The result is identical to that of JTOOLS::JCollection::lower_bound or JTOOLS::JGridCollection::lower_bound.
+   *
+   * \param  grid               grid option
+   * \param  begin              begin of abscissa values
+   * \param  end                end   of abscissa values
+   * \param  x                  abscissa value
+   * \return                    position of abscissa value
+   */
+  inline const double* getLowerBound(const bool grid, const double* begin, const double* end, const double x)
+  {
+    if (grid) {
+
+      const int n = end - begin;
+      const int k = (int) ((n - 1) * (x - *begin) / (*(end - 1) - *begin)) + 1;
+
+      if      (k <= 0)
+	return begin;
+      else if (k >= n)
+	return end;
+      else
+	return begin + k;
+
+    } else {
+
+      return std::lower_bound(begin, end, x);
+    }
+  }
+
+
+  /**
+   * Polynomial interpolation at given abscissa value.
+   *
+   * The arithmetic is identical to that of JTOOLS::JPolintFunction of the given degree,
+   * i.e.\ JTOOLS::JPolintKernel if the number of points corresponds to the degree and Neville's algorithm otherwise.
+   *
+   * \param  degree             degree of polynomial (at most 3)
+   * \param  grid               grid option
+   * \param  begin              begin of abscissa values
+   * \param  end                end   of abscissa values
+   * \param  p                  position of abscissa value of first point
+   * \param  n                  number of points
+   * \param  x                  abscissa value
+   * \param  v                  values at points (I/O)
+   * \param  getDistance        distance functor
+   * \return                    interpolated value
+   */
+  template<class T, class JDistance_t>
+  inline T getPolint(const int          degree,
+		     const bool         grid,
+		     const double*      begin,
+		     const double*      end,
+		     const double*      p,
+		     const int          n,
+		     const double       x,
+		     T*                 v,
+		     const JDistance_t& getDistance)
+  {
+    using namespace JPP;
+
+    static const int MAXIMAL_NUMBER_OF_POINTS = 4;
+
+    double u[MAXIMAL_NUMBER_OF_POINTS];
+
+    if (n == degree + 1 && (n == 3 || n == 4)) {
+
+      if (grid) {
+
+	const double f = (end - begin - 1) / getDistance(*begin, *(end - 1));
+
+	for (int i = 0; i != n; ++i) {
+	  u[i] = getDistance(p[i], x) * f;
+	}
+
+	T y;
+
+	if (n == 3)
+	  JPolintKernel<3>::lagrange(u, v, y);
+	else
+	  JPolintKernel<4>::lagrange(u, v, y);
+
+	return y;
+
+      } else {
+
+	for (int i = 0; i != n; ++i) {
+	  u[i] = getDistance(x, p[i]);
+	}
+
+	if (n == 3)
+	  JPolintKernel<3>::neville(u, v);
+	else
+	  JPolintKernel<4>::neville(u, v);
+
+	return v[0];
+      }
+    }
+
+    T w[MAXIMAL_NUMBER_OF_POINTS];
+
+    int j = 0;
+
+    for (int i = 0; i != n; ++i) {
+
+      u[i] = getDistance(x, p[i]);
+      w[i] = v[i];
+
+      if (fabs(u[i]) < fabs(u[j])) {
+	j = i;
+      }
+    }
+
+    T y = v[j];
+
+    --j;
+
+    for (int m = 1; m != n; ++m) {
+
+      for (int i = 0; i != n-m; ++i) {
+
+	const double ho = u[ i ];
+	const double hp = u[i+m];
+	const double dx = ho - hp;
+
+	v[i]  = v[i+1];
+	v[i] -= w[ i ];
+	w[i]  = v[ i ];
+
+	v[i] *= ho/dx;
+	w[i] *= hp/dx;
+      }
+
+      if (2*(j+1) < n - m)
+	y += v[j+1];
+      else
+	y += w[j--];
+    }
+
+    return y;
+  }
+
+
+  /**
+   * Interpolation of a map of a flat table at given abscissa values.
+   *
+   * The abscissa values of all maps of a level are stored consecutively.\n
+   * The function value at an abscissa value of the map is obtained with the given functor <tt>getValue(i, pX)</tt>,
+   * where <tt>i</tt> is the index of the abscissa value in the level and <tt>pX</tt> the pointer to the next abscissa values.\n
+   * Errors are passed to the given functor <tt>error(exception)</tt>, which should throw the exception or return a function value.\n
+   * The interpolation is identical to that of JTOOLS::JPolintFunction of the given degree.
+   *
+   * \param  degree             degree of polynomial (at most 3)
+   * \param  grid               grid option
+   * \param  data               begin of abscissa values of the level
+   * \param  begin              begin of abscissa values of the map
+   * \param  end                end   of abscissa values of the map
+   * \param  pX                 pointer to abscissa values
+   * \param  getValue           function value functor
+   * \param  error              error functor
+   * \param  getDistance        distance functor
+   * \return                    function value
+   */
+  template<class T, class JValue_t, class JError_t, class JDistance_t>
+  inline T getFlatValue(const int          degree,
+			const bool         grid,
+			const double*      data,
+			const double*      begin,
+			const double*      end,
+			const double*      pX,
+			const JValue_t&    getValue,
+			const JError_t&    error,
+			const JDistance_t& getDistance)
+  {
+    using namespace JPP;
+
+    static const int MAXIMAL_NUMBER_OF_POINTS = 4;
+
+    const double x = *pX;
+
+    const int size = end - begin;
+
+    if (size > 1) {
+
+      const double* p = getLowerBound(grid, begin, end, x);
+
+      if ((p == begin && getDistance(x, *(p++)) > JDistance_t::precision) ||
+	  (p == end   && getDistance(*(--p), x) > JDistance_t::precision)) {
+
+	return error(MAKE_EXCEPTION(JValueOutOfRange, "abscissa out of range "
+				    << x << " <> " << *begin << ' ' << *(end - 1)));
+      }
+
+      ++pX;  // next argument value
+
+      if (degree == 0) {
+
+	const double* q = p--;
+
+	if (q == begin || getDistance(x, *q) < getDistance(*p, x))
+	  return getValue(q - data, pX);
+	else
+	  return getValue(p - data, pX);
+
+      } else if (degree == 1) {
+
+	const double* q = p--;
+
+	const double dx = getDistance(*p, *q);
+	const double a  = getDistance(x, *q) / dx;
+	const double b  = 1.0 - a;
+
+	T ya = getValue(p - data, pX);
+	T yb = getValue(q - data, pX);
+
+	ya *= a;
+	yb *= b;
+
+	ya += yb;
+
+	return ya;
+
+      } else {
+
+	const int n = std::min(std::min(degree + 1, size), MAXIMAL_NUMBER_OF_POINTS);   // number of points to interpolate
+
+	for (int i = n/2; i != 0 && p != end;   --i, ++p) {}       // move p to begin of data
+	for (int i = n  ; i != 0 && p != begin; --i, --p) {}
+
+	T v[MAXIMAL_NUMBER_OF_POINTS] = {};
+
+	const double* const q = p;
+
+	for (int i = 0; i != n; ++p, ++i) {
+	  v[i] = getValue(p - data, pX);
+	}
+
+	return getPolint(degree, grid, begin, end, q, n, x, v, getDistance);
+      }
+
+    } else if (size == 1 && getDistance(x, *begin) <= JDistance_t::precision) {
+
+      return getValue(begin - data, ++pX);
+
+    } else {
+
+      return error(MAKE_EXCEPTION(JFunctionalException, "not enough data " << x));
+    }
+  }
+
+
+  /**
+   * Compacted one-dimensional spline functions with JTOOLS::JResultPDF as result.
+   *
+   * The abscissa, ordinate, second derivative and integral values of all functions
+   * are stored in separate contiguous arrays.
+   * The evaluation is identical to that of JTOOLS::JSplineFunction1D.
+   */
+  template<class JDistance_t = JTOOLS::JDistance<double> >
+  class JppyCompactSplinePDF {
+  public:
+
+    typedef double                                                  argument_type;
+    typedef JTOOLS::JResultPDF<double>                              result_type;
+    typedef JTOOLS::JFunctional<argument_type, result_type>         functional_type;
+    typedef typename functional_type::JExceptionHandler             exceptionhandler_type;
+
+
+    /**
+     * Default constructor.
+     */
+    JppyCompactSplinePDF() :
+      index(1, 0)
+    {}
+
+
+    /**
+     * Append function.
+     *
+     * \param  function           spline function
+     */
+    template<class JElement_t>
+    void put(const JTOOLS::JSplineFunction1D<JElement_t, JTOOLS::JCollection, result_type, JDistance_t>& function)
+    {
+      for (auto i = function.begin(); i != function.end(); ++i) {
+	abscissa  .push_back(i->getX());
+	ordinate  .push_back(i->getY());
+	derivative.push_back(i->getU());
+	integral  .push_back(i->getIntegral());
+      }
+
+      index.push_back(abscissa.size());
+    }
+
+
+    /**
+     * Get number of functions.
+     *
+     * \return                    number of functions
+     */
+    size_t size() const
+    {
+      return index.size() - 1;
+    }
+
+
+    /**
+     * Get number of nodes.
+     *
+     * \return                    number of nodes
+     */
+    size_t getNumberOfNodes() const
+    {
+      return abscissa.size();
+    }
+
+
+    /**
+     * Evaluate function.
+     *
+     * \param  i                  index of function
+     * \param  pX                 pointer to abscissa value
+     * \param  handler            exception handler
+     * \return                    function value
+     */
+    result_type evaluate(const size_t i, const argument_type* pX, const exceptionhandler_type& handler) const
+    {
+      using namespace JPP;
+
+      const argument_type x = *pX;
+
+      const size_t first = index[i];
+      const size_t last  = index[i + 1];
+
+      if (last - first <= 1u) {
+	return handler.action(MAKE_EXCEPTION(JFunctionalException, "not enough data " << x));
+      }
+
+      const double* const begin = abscissa.data() + first;
+      const double* const end   = abscissa.data() + last;
+
+      const double* p = std::lower_bound(begin, end, x);
+
+      result_type result;
+
+      if        (p == begin && getDistance(x, *(p++)) > JDistance_t::precision) {
+
+	result   = handler.action(MAKE_EXCEPTION(JValueOutOfRange, "abscissa out of range " << x << " < " << *begin));
+
+	// overwrite integral values
+
+	result.v = 0;
+	result.V = integral[last - 1];
+
+	return result;
+
+      } else if (p == end   && getDistance(*(--p), x) > JDistance_t::precision) {
+
+	result   = handler.action(MAKE_EXCEPTION(JValueOutOfRange, "abscissa out of range " << x << " > " << *(end - 1)));
+
+	// overwrite integral values
+
+	result.v = integral[last - 1];
+	result.V = integral[last - 1];
+
+	return result;
+      }
+
+      const size_t q = p - abscissa.data();
+      const size_t r = q - 1;
+
+      const double yp = ordinate  [r];
+      const double yq = ordinate  [q];
+      const double up = derivative[r];
+      const double uq = derivative[q];
+
+      const double dx = getDistance(abscissa[r], abscissa[q]);
+      const double a  = getDistance(x, abscissa[q]) / dx;
+      const double b  = 1.0 - a;
+
+      result.f  = a * yp + b * yq
+	- a*b * ((a + 1.0)*up + (b + 1.0)*uq) * dx*dx/6;
+
+      result.fp = (yq - yp + (up*(1.0 - 3*a*a) -
+			      uq*(1.0 - 3*b*b)) * dx*dx/6) / dx;
+
+      result.v  = integral[r]
+	+ 0.5*dx * (yp - 0.5*up*dx*dx/6)
+	- 0.5*dx * ((a*a*yp - b*b*yq) +
+		    (up * a*a*(0.5*a*a - 1.0) -
+		     uq * b*b*(0.5*b*b - 1.0)) * dx*dx/6);
+
+      result.V  = integral[last - 1];
+
+      return result;
+    }
+
+  private:
+    JDistance_t         getDistance;
+    std::vector<size_t> index;         //!< offset of each function
+    std::vector<double> abscissa;      //!< abscissa values
+    std::vector<double> ordinate;      //!< ordinate values
+    std::vector<double> derivative;    //!< second derivatives
+    std::vector<double> integral;      //!< integral values
+  };
+
+
+  /**
+   * Compacted constant functions.
+   */
+  class JppyCompactConstant {
+  public:
+
+    typedef double                                                  argument_type;
+    typedef double                                                  result_type;
+    typedef JTOOLS::JFunctional<argument_type, result_type>         functional_type;
+    typedef functional_type::JExceptionHandler                      exceptionhandler_type;
+
+
+    /**
+     * Append function.
+     *
+     * \param  function           constant function
+     */
+    void put(const JTOOLS::JConstantFunction1D<argument_type, result_type>& function)
+    {
+      y.push_back(function.getY());
+    }
+
+
+    /**
+     * Get number of functions.
+     *
+     * \return                    number of functions
+     */
+    size_t size() const
+    {
+      return y.size();
+    }
+
+
+    /**
+     * Get number of nodes.
+     *
+     * \return                    number of nodes
+     */
+    size_t getNumberOfNodes() const
+    {
+      return y.size();
+    }
+
+
+    /**
+     * Evaluate function.
+     *
+     * The pointer to the abscissa value and the exception handler of the common interface of compacted functions
+     * are not used, since the function value does not depend on the abscissa value.
+     *
+     * \param  i                  index of function
+     * \return                    function value
+     */
+    result_type evaluate(const size_t i, const argument_type*, const exceptionhandler_type&) const
+    {
+      return y[i];
+    }
+
+  private:
+    std::vector<double> y;             //!< ordinate values
+  };
+
+
+  /**
+   * Compacted read-only multi-dimensional function.
+   *
+   * The abscissa values of all maps at a given level of a multi-dimensional function (i.e.\ JTOOLS::JMultiFunction)
+   * are stored in a single contiguous array, together with the offset of each map in this array.
+   * The element at position <tt>i</tt> of this array refers to the map (or function) at position <tt>i</tt> of the next level.
+   * The functions at the lowest level are stored in the same way by the given compacted function type.
+   *
+   * The interpolations and the handling of exceptions are identical to those of the original multi-dimensional function,
+   * provided that the same exception handler is used at all levels (see JTOOLS::JMultiFunction::setExceptionHandler).
+   */
+  template<class JLeaf_t,
+	   class JMaplist_t,
+	   class JDistance_t = JTOOLS::JDistance<double> >
+  class JppyCompactMultiFunction {
+  public:
+
+    enum { NUMBER_OF_MAPS = JTOOLS::JMapLength<JMaplist_t>::value };
+
+    typedef JLeaf_t                                                 leaf_type;
+    typedef typename leaf_type::argument_type                       argument_type;
+    typedef typename leaf_type::result_type                         result_type;
+    typedef typename leaf_type::functional_type                     functional_type;
+    typedef typename functional_type::JSupervisor                   supervisor_type;
+
+    static const int MAXIMAL_DEGREE = 3;
+
+
+    /**
+     * Default constructor.
+     */
+    JppyCompactMultiFunction()
+    {
+      getCompactMaps(degree, grid, (JMaplist_t*) NULL);
+    }
+
+
+    /**
+     * Constructor.
+     *
+     * \param  input              multi-dimensional function
+     */
+    template<class JMultiFunction_t>
+    JppyCompactMultiFunction(const JMultiFunction_t& input) :
+      supervisor(input.getSupervisor())
+    {
+      getCompactMaps(degree, grid, (JMaplist_t*) NULL);
+
+      for (int i = 0; i != NUMBER_OF_MAPS; ++i) {
+	index[i].push_back(0);
+      }
+
+      put(input, std::integral_constant<int, 0>());
+    }
+
+
+    /**
+     * Get minimal abscissa value of first dimension.
+     *
+     * \return                    abscissa value
+     */
+    argument_type getXmin() const
+    {
+      return abscissa[0].front();
+    }
+
+
+    /**
+     * Get maximal abscissa value of first dimension.
+     *
+     * \return                    abscissa value
+     */
+    argument_type getXmax() const
+    {
+      return abscissa[0].back();
+    }
+
+
+    /**
+     * Get number of nodes.
+     *
+     * \return                    total number of nodes at all levels
+     */
+    size_t getNumberOfNodes() const
+    {
+      size_t n = leaf.getNumberOfNodes();
+
+      for (int i = 0; i != NUMBER_OF_MAPS; ++i) {
+	n += abscissa[i].size();
+      }
+
+      return n;
+    }
+
+
+    /**
+     * Get exception handler.
+     *
+     * \return                    exception handler
+     */
+    const typename leaf_type::exceptionhandler_type& getExceptionHandler() const
+    {
+      return *supervisor;
+    }
+
+
+    /**
+     * Recursive function value evaluation.
+     *
+     * \param  pX                 pointer to abscissa values
+     * \return                    function value
+     */
+    result_type evaluate(const argument_type* pX) const
+    {
+      return evaluate(0, 0, pX);
+    }
+
+  private:
+    /**
+     * Append map.
+     *
+     * The level of the map is given by the second (unnamed) argument.
+     *
+     * \param  input              map
+     */
+    template<class JMap_t, int N>
+    void put(const JMap_t& input, std::integral_constant<int, N>)
+    {
+      for (auto i = input.begin(); i != input.end(); ++i) {
+	abscissa[N].push_back(i->getX());
+      }
+
+      index[N].push_back(abscissa[N].size());
+
+      for (auto i = input.begin(); i != input.end(); ++i) {
+	put(i->getY(), std::integral_constant<int, N + 1>());
+      }
+    }
+
+
+    /**
+     * Append function.
+     *
+     * This method terminates the recursion at the lowest level.
+     *
+     * \param  input              function
+     */
+    template<class JFunction_t>
+    void put(const JFunction_t& input, std::integral_constant<int, NUMBER_OF_MAPS>)
+    {
+      leaf.put(input);
+    }
+
+
+    /**
+     * Get function value of map or function at given level.
+     *
+     * \param  level              level
+     * \param  i                  index of map or function
+     * \param  pX                 pointer to abscissa values
+     * \return                    function value
+     */
+    result_type getValue(const int level, const size_t i, const argument_type* pX) const
+    {
+      if (level == NUMBER_OF_MAPS)
+	return leaf.evaluate(i, pX, getExceptionHandler());
+      else
+	return evaluate(level, i, pX);
+    }
+
+
+    /**
+     * Recursive interpolation method implementation.
+     *
+     * \param  level              level
+     * \param  node               index of map
+     * \param  pX                 pointer to abscissa values
+     * \return                    function value
+     */
+    result_type evaluate(const int level, const size_t node, const argument_type* pX) const
+    {
+      const double* const data = abscissa[level].data();
+
+      return getFlatValue<result_type>(degree[level],
+				       grid  [level],
+				       data,
+				       data + index[level][node],
+				       data + index[level][node + 1],
+				       pX,
+				       [this, level](const size_t i, const argument_type* pX) { return getValue(level + 1, i, pX); },
+				       [this](const JLANG::JException& error) { return getExceptionHandler().action(error); },
+				       getDistance);
+    }
+
+    int                 degree  [NUMBER_OF_MAPS];
+    bool                grid    [NUMBER_OF_MAPS];
+    std::vector<size_t> index   [NUMBER_OF_MAPS];    //!< offset of each map per level
+    std::vector<double> abscissa[NUMBER_OF_MAPS];    //!< abscissa values per level
+    leaf_type           leaf;
+    supervisor_type     supervisor;
+    JDistance_t         getDistance;
+  };
+
+
+  /**
+   * Compacted read-only PDF table.
+   *
+   * The template arguments correspond to those of the original PDF table (i.e.\ JPHYSICS::JPDFTable).
+   * The evaluation is identical to that of the original PDF table.
+   */
+  template<class JFunction1D_t,
+	   class JMaplist_t,
+	   class JDistance_t = JTOOLS::JDistance<typename JFunction1D_t::argument_type> >
+  class JppyCompactPDFTable :
+    public JppyCompactMultiFunction<JppyCompactSplinePDF<JDistance_t>, JMaplist_t, JDistance_t>
+  {
+  public:
+
+    typedef JPDFTable<JFunction1D_t, JMaplist_t, JDistance_t>                           JPDFTable_t;
+    typedef JppyCompactMultiFunction<JppyCompactSplinePDF<JDistance_t>,
+				     JMaplist_t,
+				     JDistance_t>                                       multifunction_type;
+
+    enum { NUMBER_OF_DIMENSIONS = JPDFTable_t::NUMBER_OF_DIMENSIONS };
+
+    typedef typename JPDFTable_t::transformer_type                                      transformer_type;
+    typedef typename JPDFTable_t::argument_type                                         argument_type;
+    typedef typename JPDFTable_t::result_type                                           result_type;
+    typedef JTOOLS::JArray<NUMBER_OF_DIMENSIONS, argument_type>                         array_type;
+
+
+    /**
+     * Default constructor.
+     */
+    JppyCompactPDFTable()
+    {}
+
+
+    /**
+     * Constructor.
+     *
+     * \param  table              PDF table
+     */
+    JppyCompactPDFTable(const JPDFTable_t& table) :
+      multifunction_type(table),
+      transformer(table.transformer->clone())
+    {}
+
+
+    /**
+     * Get PDF.
+     *
+     * \param  pX                 pointer to abscissa values
+     * \return                    function value
+     */
+    result_type evaluate(const argument_type* pX) const
+    {
+      using namespace JPP;
+
+      array_type buffer(pX);
+
+      buffer[NUMBER_OF_DIMENSIONS - 1] = transformer->putXn(buffer, buffer[NUMBER_OF_DIMENSIONS - 1]);
+
+      const result_type y = multifunction_type::evaluate(buffer.data());
+      const double      W = transformer->getWeight(buffer);
+
+      return JResultTransformer<result_type>::transform(*transformer, buffer, y) * W;
+    }
+
+
+    /**
+     * Get PDF.
+     *
+     * \param  args               comma separated list of abscissa values
+     * \return                    function value
+     */
+    template<class ...Args>
+    result_type operator()(const Args& ...args) const
+    {
+      const array_type buffer(args...);
+
+      return this->evaluate(buffer.data());
+    }
+
+  private:
+    JLANG::JSharedPointer<transformer_type> transformer;
+  };
+
+
+  /**
+   * Compacted read-only NPE table.
+   *
+   * The template arguments correspond to those of the original NPE table (i.e.\ JPHYSICS::JNPETable).
+   * The evaluation is identical to that of the original NPE table.
+   */
+  template<class JArgument_t,
+	   class JResult_t,
+	   class JMaplist_t,
+	   class JDistance_t = JTOOLS::JDistance<JArgument_t> >
+  class JppyCompactNPETable :
+    public JppyCompactMultiFunction<JppyCompactConstant, JMaplist_t, JDistance_t>
+  {
+  public:
+
+    typedef JNPETable<JArgument_t, JResult_t, JMaplist_t, JDistance_t>                  JNPETable_t;
+    typedef JppyCompactMultiFunction<JppyCompactConstant, JMaplist_t, JDistance_t>      multifunction_type;
+
+    enum { NUMBER_OF_DIMENSIONS = JNPETable_t::NUMBER_OF_DIMENSIONS };
+
+    typedef typename JNPETable_t::transformer_type                                      transformer_type;
+    typedef typename JNPETable_t::argument_type                                         argument_type;
+    typedef typename JNPETable_t::result_type                                           result_type;
+    typedef JTOOLS::JArray<NUMBER_OF_DIMENSIONS, argument_type>                         array_type;
+
+
+    /**
+     * Default constructor.
+     */
+    JppyCompactNPETable()
+    {}
+
+
+    /**
+     * Constructor.
+     *
+     * \param  table              NPE table
+     */
+    JppyCompactNPETable(const JNPETable_t& table) :
+      multifunction_type(table),
+      transformer(table.transformer->clone())
+    {}
+
+
+    /**
+     * Get number of photo-electrons.
+     *
+     * \param  pX                 pointer to abscissa values
+     * \return                    number of photo-electrons
+     */
+    result_type evaluate(const argument_type* pX) const
+    {
+      const array_type buffer(pX);
+
+      const double      W   = transformer->getWeight(buffer);
+      const result_type npe = multifunction_type::evaluate(buffer.data());
+
+      return W * npe;
+    }
+
+
+    /**
+     * Get number of photo-electrons.
+     *
+     * \param  args               comma separated list of abscissa values
+     * \return                    number of photo-electrons
+     */
+    template<class ...Args>
+    result_type operator()(const Args& ...args) const
+    {
+      const array_type buffer(args...);
+
+      return this->evaluate(buffer.data());
+    }
+
+  private:
+    JLANG::JSharedPointer<transformer_type> transformer;
+  };
+}
+
+#endif
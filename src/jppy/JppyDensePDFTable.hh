@@ -0,0 +1,527 @@
+#ifndef __JPHYSICS__JPPYDENSEPDFTABLE__
+#define __JPHYSICS__JPPYDENSEPDFTABLE__
+
+#include <vector>
+#include <limits>
+#include <random>
+#include <cmath>
+#include <algorithm>
+
+#include "JTools/JArray.hh"
+#include "JTools/JMapList.hh"
+#include "JTools/JFunctionalMap_t.hh"
+#include "JTools/JResult.hh"
+#include "JTools/JResultTransformer.hh"
+#include "JLang/JSharedPointer.hh"
+#include "JLang/JException.hh"
+#include "JPhysics/JPDFTable.hh"
+
+#include "JppyThreadPool.hh"
+
+
+/**
+ * \file
+ *
+ * PDF table resampled on uniform grids.
+ */
+
+namespace JPHYSICS {}
+namespace JPP { using namespace JPHYSICS; }
+
+namespace JPHYSICS {
+
+  using JLANG::JValueOutOfRange;
+
+
+  /**
+   * Auxiliary data structure for the interpolation degree of a functional map.\n
+   * By default, a functional map is approximated by a linear interpolation.
+   */
+  template<template<class, class, class> class JMap_t>
+  struct JppyPolintDegree {
+    enum { value = 1 };
+  };
+
+
+  /**
+   * Template specialisation for zero degree polynomial interpolation (i.e.\ nearest node).
+   */
+  template<>
+  struct JppyPolintDegree<JTOOLS::JPolint0FunctionalMap> {
+    enum { value = 0 };
+  };
+
+
+  /**
+   * Template specialisation for zero degree polynomial interpolation (i.e.\ nearest node).
+   */
+  template<>
+  struct JppyPolintDegree<JTOOLS::JPolint0FunctionalGridMap> {
+    enum { value = 0 };
+  };
+
+
+  /**
+   * Template specialisation for zero degree polynomial interpolation (i.e.\ nearest node).
+   */
+  template<>
+  struct JppyPolintDegree<JTOOLS::JPolint0FunctionalLookupMap> {
+    enum { value = 0 };
+  };
+
+
+  /**
+   * Get interpolation degrees of given map list.
+   *
+   * Termination of recursion.
+   */
+  inline void getPolintDegrees(int*, const JLANG::JNullType*)
+  {}
+
+
+  /**
+   * Get interpolation degrees of given map list.
+   *
+   * \param  degree             pointer to output
+   * \param  maplist            map list
+   */
+  template<template<class, class, class> class JHead_t, class JTail_t>
+  inline void getPolintDegrees(int* degree, const JTOOLS::JMapList<JHead_t, JTail_t>*)
+  {
+    *degree = JppyPolintDegree<JHead_t>::value;
+
+    getPolintDegrees(++degree, (JTail_t*) NULL);
+  }
+
+
+  /**
+   * Multi-dimensional PDF table resampled on uniform grids.
+   *
+   * The values of the given PDF table are sampled at the nodes of uniform grids in each dimension,
+   * including the transformed abscissa of the innermost dimension.
+   * The sampled values are stored in a single contiguous array, so that the look-up of the enclosing cell
+   * is reduced to index arithmetic.
+   * The PDF is then evaluated using multi-linear interpolation between the corners of the cell
+   * and the coordinate transformation and weight of the original table.
+   * Dimensions which are interpolated by a zero degree polynomial in the original table
+   * are evaluated at the nearest node.
+   *
+   * The template arguments correspond to those of the original PDF table (i.e.\ JPHYSICS::JPDFTable).
+   */
+  template<class JFunction1D_t,
+	   class JMaplist_t,
+	   class JDistance_t = JTOOLS::JDistance<typename JFunction1D_t::argument_type> >
+  class JppyDensePDFTable {
+  public:
+
+    typedef JPDFTable<JFunction1D_t, JMaplist_t, JDistance_t>                 JPDFTable_t;
+
+    enum { NUMBER_OF_DIMENSIONS = JPDFTable_t::NUMBER_OF_DIMENSIONS };
+
+    typedef typename JPDFTable_t::multifunction_type                          multifunction_type;
+    typedef typename JPDFTable_t::transformer_type                            transformer_type;
+    typedef typename JPDFTable_t::super_const_iterator                        super_const_iterator;
+    typedef typename JPDFTable_t::argument_type                               argument_type;
+    typedef typename JPDFTable_t::result_type                                 result_type;
+    typedef typename JPDFTable_t::function_type::supervisor_type              supervisor_type;
+    typedef JTOOLS::JArray<NUMBER_OF_DIMENSIONS, argument_type>               array_type;
+
+
+    /**
+     * Uniform grid.
+     */
+    struct JAxis {
+      /**
+       * Default constructor.
+       */
+      JAxis() :
+	xmin( std::numeric_limits<double>::max()),
+	xmax(-std::numeric_limits<double>::max()),
+	n(0)
+      {}
+
+
+      /**
+       * Get abscissa value of node.
+       *
+       * \param  i            index
+       * \return              abscissa value
+       */
+      double getX(const int i) const
+      {
+	return (i + 1 == n ? xmax : xmin + i * (xmax - xmin) / (n - 1));
+      }
+
+
+      /**
+       * Get index of lower node of enclosing cell and relative position inside cell.
+       *
+       * The abscissa value should be within the range of the grid.
+       *
+       * \param  x            abscissa value
+       * \param  u            relative position inside cell
+       * \return              index
+       */
+      int getIndex(const double x, double& u) const
+      {
+	const double z = (x - xmin) * (n - 1) / (xmax - xmin);
+
+	const int i = std::min(std::max((int) z, 0), n - 2);
+
+	u = z - i;
+
+	return i;
+      }
+
+
+      /**
+       * Get index of nearest node.
+       *
+       * The abscissa value should be within the range of the grid.
+       *
+       * \param  x            abscissa value
+       * \return              index
+       */
+      int getNearestIndex(const double x) const
+      {
+	const double z = (x - xmin) * (n - 1) / (xmax - xmin);
+
+	return std::min(std::max((int) (z + 0.5), 0), n - 1);
+      }
+
+
+      /**
+       * Check validity of abscissa value.
+       *
+       * \param  x            abscissa value
+       * \return              true if within range; else false
+       */
+      bool in_range(const double x) const
+      {
+	return x >= xmin && x <= xmax;
+      }
+
+      double xmin;    //!< minimal abscissa value
+      double xmax;    //!< maximal abscissa value
+      int    n;       //!< number of nodes
+    };
+
+
+    /**
+     * Default constructor.
+     */
+    JppyDensePDFTable()
+    {}
+
+
+    /**
+     * Constructor.
+     *
+     * The range of each grid corresponds to the range of the PDF table in the given dimension.\n
+     * The number of nodes of a grid defaults to the number of distinct nodes of the PDF table in the given dimension
+     * (for the innermost dimension, the maximal number of nodes of any one-dimensional function).
+     * Note that the memory consumption is proportional to the product of the number of nodes.
+     *
+     * \param  table              PDF table
+     * \param  numberOfPoints     number of nodes per dimension (0 = default)
+     */
+    JppyDensePDFTable(const JPDFTable_t&         table,
+		      const std::vector<size_t>& numberOfPoints = std::vector<size_t>())
+    {
+      using namespace std;
+      using namespace JPP;
+
+      if (!numberOfPoints.empty() && numberOfPoints.size() != NUMBER_OF_DIMENSIONS) {
+	THROW(JValueOutOfRange, "JppyDensePDFTable::JppyDensePDFTable(): Wrong number of dimensions " << numberOfPoints.size() << " != " << NUMBER_OF_DIMENSIONS);
+      }
+
+      getPolintDegrees(degree, (JMaplist_t*) NULL);
+
+      degree[NUMBER_OF_DIMENSIONS - 1] = 1;
+
+      // determine range and default number of nodes in each dimension
+
+      vector<vector<double> > keys(NUMBER_OF_DIMENSIONS - 1);
+
+      for (super_const_iterator i = table.super_begin(); i != table.super_end(); ++i) {
+
+	const JArray<NUMBER_OF_DIMENSIONS - 1, argument_type> key((*i).getKey());
+	const typename JPDFTable_t::function_type&           f1 = (*i).getValue();
+
+	for (int k = 0; k != NUMBER_OF_DIMENSIONS - 1; ++k) {
+	  keys[k].push_back(key[k]);
+	}
+
+	if (!f1.empty()) {
+
+	  JAxis& axis = this->axis[NUMBER_OF_DIMENSIONS - 1];
+
+	  axis.xmin = min(axis.xmin, f1.begin() ->getX());
+	  axis.xmax = max(axis.xmax, f1.rbegin()->getX());
+	  axis.n    = max(axis.n,    (int) f1.size());
+	}
+      }
+
+      for (int k = 0; k != NUMBER_OF_DIMENSIONS - 1; ++k) {
+
+	sort(keys[k].begin(), keys[k].end());
+
+	keys[k].erase(unique(keys[k].begin(), keys[k].end()), keys[k].end());
+
+	if (!keys[k].empty()) {
+	  axis[k].xmin = keys[k].front();
+	  axis[k].xmax = keys[k].back();
+	  axis[k].n    = keys[k].size();
+	}
+      }
+
+      for (int k = 0; k != NUMBER_OF_DIMENSIONS; ++k) {
+
+	if (!numberOfPoints.empty() && numberOfPoints[k] != 0) {
+	  axis[k].n = numberOfPoints[k];
+	}
+
+	if (axis[k].n < 2 || !(axis[k].xmax > axis[k].xmin)) {
+	  THROW(JValueOutOfRange, "JppyDensePDFTable::JppyDensePDFTable(): Invalid grid in dimension " << k);
+	}
+      }
+
+      size_t size = 1;
+
+      for (int k = NUMBER_OF_DIMENSIONS - 1; k >= 0; --k) {
+	stride[k]  = size;
+	size      *= axis[k].n;
+      }
+
+      // sample PDF table
+
+      data.resize(size);
+
+      const multifunction_type& function = table;
+
+      UTILS::getThreadPool().execute(size, 0, [&](const size_t begin, const size_t end) {
+
+	  array_type x;
+
+	  for (size_t i = begin; i != end; ++i) {
+
+	    for (int k = 0; k != NUMBER_OF_DIMENSIONS; ++k) {
+	      x[k] = axis[k].getX((i / stride[k]) % axis[k].n);
+	    }
+
+	    data[i] = function.multifunction_type::evaluate(x.data());
+	  }
+	});
+
+      transformer.reset(table.transformer->clone());
+
+      supervisor = table.getSupervisor();
+    }
+
+
+    /**
+     * Get number of nodes.
+     *
+     * \return                    number of nodes
+     */
+    size_t getSize() const
+    {
+      return data.size();
+    }
+
+
+    /**
+     * Get grid.
+     *
+     * \param  k                  dimension
+     * \return                    grid
+     */
+    const JAxis& getAxis(const int k) const
+    {
+      return axis[k];
+    }
+
+
+    /**
+     * Get PDF.
+     *
+     * Abscissa values out of range are handled as by the original PDF table,
+     * i.e.\ the result is provided by the exception handler of the original PDF table
+     * and, for the arrival time, the integral values are set to those at the edge of the grid.
+     *
+     * \param  pX                 pointer to abscissa values
+     * \return                    function value
+     */
+    result_type evaluate(const argument_type* pX) const
+    {
+      using namespace JPP;
+
+      array_type buffer(pX);
+
+      buffer[NUMBER_OF_DIMENSIONS - 1] = transformer->putXn(buffer, buffer[NUMBER_OF_DIMENSIONS - 1]);
+
+      const result_type y = interpolate(buffer);
+      const double      W = transformer->getWeight(buffer);
+
+      return JResultTransformer<result_type>::transform(*transformer, buffer, y) * W;
+    }
+
+
+    /**
+     * Get PDF.
+     *
+     * \param  args               comma separated list of abscissa values
+     * \return                    function value
+     */
+    template<class ...Args>
+    result_type operator()(const Args& ...args) const
+    {
+      const array_type buffer(args...);
+
+      return this->evaluate(buffer.data());
+    }
+
+
+    /**
+     * Get maximal deviation with respect to given PDF table.
+     *
+     * The deviation is evaluated at random points inside the grid for each of the PDF value, its derivative
+     * and the partial and total integrals.
+     * The deviation of each of these is expressed relative to its maximal absolute value at these points.
+     *
+     * \param  table              PDF table
+     * \param  numberOfTests      number of random points
+     * \return                    maximal relative deviation
+     */
+    double getMaximalDeviation(const JPDFTable_t& table, const size_t numberOfTests = 100000) const
+    {
+      using namespace std;
+
+      mt19937 generator(1);
+
+      double ymax[4] = { 0.0, 0.0, 0.0, 0.0 };    // f, fp, v, V
+      double dmax[4] = { 0.0, 0.0, 0.0, 0.0 };    // f, fp, v, V
+
+      for (size_t n = 0; n != numberOfTests; ++n) {
+
+	array_type x;
+
+	for (int k = 0; k != NUMBER_OF_DIMENSIONS; ++k) {
+	  x[k] = uniform_real_distribution<double>(axis[k].xmin, axis[k].xmax)(generator);
+	}
+
+	x[NUMBER_OF_DIMENSIONS - 1] = transformer->getXn(x, x[NUMBER_OF_DIMENSIONS - 1]);
+
+	const result_type y0 = table.evaluate(x.data());
+	const result_type y1 = this->evaluate(x.data());
+
+	const double u0[] = { y0.f, y0.fp, y0.v, y0.V };
+	const double u1[] = { y1.f, y1.fp, y1.v, y1.V };
+
+	for (int i = 0; i != 4; ++i) {
+	  ymax[i] = max(ymax[i], fabs(u0[i]));
+	  dmax[i] = max(dmax[i], fabs(u1[i] - u0[i]));
+	}
+      }
+
+      double deviation = 0.0;
+
+      for (int i = 0; i != 4; ++i) {
+	deviation = max(deviation, (ymax[i] > 0.0 ? dmax[i] / ymax[i] : dmax[i]));
+      }
+
+      return deviation;
+    }
+
+  private:
+    /**
+     * Interpolate sampled values.
+     *
+     * \param  x                  abscissa values, including transformed abscissa value of innermost dimension
+     * \return                    function value
+     */
+    result_type interpolate(const array_type& x) const
+    {
+      using namespace JPP;
+
+      for (int k = 0; k != NUMBER_OF_DIMENSIONS - 1; ++k) {
+	if (!axis[k].in_range(x[k])) {
+	  return supervisor->action(MAKE_EXCEPTION(JValueOutOfRange, "abscissa out of range " << x[k] << " <> " << axis[k].xmin << ' ' << axis[k].xmax));
+	}
+      }
+
+      const JAxis&        axis_t = axis[NUMBER_OF_DIMENSIONS - 1];
+      const argument_type z      = x[NUMBER_OF_DIMENSIONS - 1];
+
+      size_t index = 0;
+      double u[NUMBER_OF_DIMENSIONS];
+      size_t s[NUMBER_OF_DIMENSIONS];
+      int    m = 0;
+
+      for (int k = 0; k != NUMBER_OF_DIMENSIONS; ++k) {
+
+	const double xk = (k + 1 == NUMBER_OF_DIMENSIONS ? std::min(std::max(z, axis_t.xmin), axis_t.xmax) : x[k]);
+
+	if (degree[k] == 0) {
+
+	  index += axis[k].getNearestIndex(xk) * stride[k];
+
+	} else {
+
+	  index += axis[k].getIndex(xk, u[m]) * stride[k];
+
+	  s[m++] = stride[k];
+	}
+      }
+
+      result_type y(0.0, 0.0, 0.0, 0.0);
+
+      for (int corner = 0; corner != (1 << m); ++corner) {
+
+	size_t i = index;
+	double w = 1.0;
+
+	for (int k = 0; k != m; ++k) {
+
+	  if (corner & (1 << k)) {
+	    i += s[k];
+	    w *= u[k];
+	  } else {
+	    w *= 1.0 - u[k];
+	  }
+	}
+
+	const result_type& yi = data[i];
+
+	y.f  += w * yi.f;
+	y.fp += w * yi.fp;
+	y.v  += w * yi.v;
+	y.V  += w * yi.V;
+      }
+
+      if (!axis_t.in_range(z)) {
+
+	// keep integral values, as in the one-dimensional PDF
+
+	const double V = y.V;
+	const double v = (z < axis_t.xmin ? 0.0 : V);
+
+	y   = supervisor->action(MAKE_EXCEPTION(JValueOutOfRange, "abscissa out of range " << z << " <> " << axis_t.xmin << ' ' << axis_t.xmax));
+	y.v = v;
+	y.V = V;
+      }
+
+      return y;
+    }
+
+
+    int                                     degree[NUMBER_OF_DIMENSIONS];
+    JAxis                                   axis  [NUMBER_OF_DIMENSIONS];
+    size_t                                  stride[NUMBER_OF_DIMENSIONS];
+    std::vector<result_type>                data;
+    JLANG::JSharedPointer<transformer_type> transformer;
+    supervisor_type                         supervisor;
+  };
+}
+
+#endif
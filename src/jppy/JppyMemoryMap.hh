@@ -0,0 +1,218 @@
+#ifndef __JPPY_MEMORYMAP__
+#define __JPPY_MEMORYMAP__
+
+#include <cstddef>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "JLang/JException.hh"
+
+
+/**
+ * \file
+ *
+ * Read-only memory mapping of files and shared memory.
+ */
+
+namespace UTILS {
+
+  using JLANG::JFileOpenException;
+  using JLANG::JFileReadException;
+  using JLANG::JIOException;
+
+
+  /**
+   * Read-only memory mapping of a file.
+   *
+   * The mapping is shared, so that all processes which map the same file use the same pages of the page cache.
+   */
+  class JppyMemoryMap {
+  public:
+    /**
+     * Constructor.
+     *
+     * \param  fileName           file name
+     */
+    JppyMemoryMap(const char* fileName) :
+      buffer(NULL),
+      length(0)
+    {
+      const int fd = ::open(fileName, O_RDONLY);
+
+      if (fd == -1) {
+	THROW(JFileOpenException, "JppyMemoryMap::JppyMemoryMap(): Error opening file " << fileName);
+      }
+
+      map(fd, fileName);
+    }
+
+
+    /**
+     * Destructor.
+     */
+    virtual ~JppyMemoryMap()
+    {
+      if (buffer != NULL) {
+	::munmap(buffer, length);
+      }
+    }
+
+
+    /**
+     * Get pointer to mapped data.
+     *
+     * \return                    pointer to data
+     */
+    const char* data() const
+    {
+      return static_cast<const char*>(buffer);
+    }
+
+
+    /**
+     * Get size of mapped data.
+     *
+     * \return                    number of bytes
+     */
+    size_t size() const
+    {
+      return length;
+    }
+
+  protected:
+    /**
+     * Default constructor.
+     */
+    JppyMemoryMap() :
+      buffer(NULL),
+      length(0)
+    {}
+
+
+    /**
+     * Map file read-only.
+     *
+     * The file descriptor is closed.
+     *
+     * \param  fd                 file descriptor
+     * \param  fileName           file name
+     */
+    void map(const int fd, const char* fileName)
+    {
+      struct stat status;
+
+      if (::fstat(fd, &status) != 0 || status.st_size == 0) {
+
+	::close(fd);
+
+	THROW(JFileReadException, "JppyMemoryMap::map(): Error reading file " << fileName);
+      }
+
+      length = status.st_size;
+      buffer = ::mmap(NULL, length, PROT_READ, MAP_SHARED, fd, 0);
+
+      ::close(fd);
+
+      if (buffer == MAP_FAILED) {
+
+	buffer = NULL;
+
+	THROW(JFileReadException, "JppyMemoryMap::map(): Error mapping file " << fileName);
+      }
+    }
+
+  private:
+    JppyMemoryMap(const JppyMemoryMap&);
+    JppyMemoryMap& operator=(const JppyMemoryMap&);
+
+    void*  buffer;
+    size_t length;
+  };
+
+
+  /**
+   * Read-only memory mapping of a POSIX shared memory object.
+   */
+  class JppySharedMemory :
+    public JppyMemoryMap
+  {
+  public:
+    /**
+     * Constructor.
+     *
+     * The shared memory object should exist (see method create).
+     *
+     * \param  name               name of shared memory object
+     */
+    JppySharedMemory(const char* name) :
+      JppyMemoryMap()
+    {
+      const int fd = ::shm_open(name, O_RDONLY, 0);
+
+      if (fd == -1) {
+	THROW(JFileOpenException, "JppySharedMemory::JppySharedMemory(): Error opening shared memory " << name);
+      }
+
+      map(fd, name);
+    }
+
+
+    /**
+     * Create shared memory object with given data.
+     *
+     * An existing shared memory object with the same name is not overwritten.
+     *
+     * \param  name               name of shared memory object
+     * \param  data               pointer to data
+     * \param  size               number of bytes
+     */
+    static void create(const char* name, const void* data, const size_t size)
+    {
+      const int fd = ::shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0644);
+
+      if (fd == -1) {
+	THROW(JFileOpenException, "JppySharedMemory::create(): Error creating shared memory " << name);
+      }
+
+      void* buffer = MAP_FAILED;
+
+      if (::ftruncate(fd, size) == 0) {
+	buffer = ::mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      }
+
+      ::close(fd);
+
+      if (buffer == MAP_FAILED) {
+
+	::shm_unlink(name);
+
+	THROW(JIOException, "JppySharedMemory::create(): Error allocating shared memory " << name << " of size " << size);
+      }
+
+      memcpy(buffer, data, size);
+
+      ::munmap(buffer, size);
+    }
+
+
+    /**
+     * Remove shared memory object.
+     *
+     * The memory is released when it is no longer mapped by any process.
+     *
+     * \param  name               name of shared memory object
+     */
+    static void unlink(const char* name)
+    {
+      if (::shm_unlink(name) != 0) {
+	THROW(JFileOpenException, "JppySharedMemory::unlink(): Error removing shared memory " << name);
+      }
+    }
+  };
+}
+
+#endif
@@ -0,0 +1,307 @@
+#ifndef __JPHYSICS__JPPYNPE__
+#define __JPHYSICS__JPPYNPE__
+
+#include <string>
+#include <vector>
+#include <memory>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+#include "JPhysics/JNPE_t.hh"
+#include "JPhysics/JConstants.hh"
+
+#include "utils.hh"
+#include "JppyThreadPool.hh"
+#include "JppyCompactTable.hh"
+
+
+/**
+ * \file
+ *
+ * Auxiliary data structures for vectorised evaluation of NPE tables.
+ */
+
+namespace JPHYSICS {}
+namespace JPP { using namespace JPHYSICS; }
+
+namespace JPHYSICS {
+
+  namespace py = pybind11;
+
+  using UTILS::array_type;
+  using UTILS::JBroadcastArray;
+  using UTILS::vectorize;
+
+
+  /**
+   * Auxiliary data structure for muon NPE with vectorised evaluation.
+   */
+  struct JppyMuonNPE :
+    public JMuonNPE_t
+  {
+    /**
+     * Constructor.
+     *
+     * The PDF files are loaded concurrently and each pair of NPE tables is added as soon as both have been computed.
+     *
+     * \param  fileDescriptor     PDF file descriptor
+     */
+    JppyMuonNPE(const std::string& fileDescriptor)
+    {
+      load(fileDescriptor, UTILS::JConcurrentLoader());
+    }
+
+
+    /**
+     * Compact NPE tables.
+     *
+     * The NPE tables are converted to compacted read-only tables, in which all nodes are stored in contiguous arrays.\n
+     * After this call, all subsequent evaluations make use of the compacted NPE tables.
+     * The compacted NPE tables are published atomically, so that concurrent evaluations use either the original or the compacted NPE tables.
+     * The results are identical to those of the original NPE tables.
+     *
+     * Note that the original NPE tables are kept,
+     * so that the memory consumption is about twice that of the original NPE tables.
+     */
+    void compact()
+    {
+      std::atomic_store(&compacted, std::make_shared<const JTables>(Y1, YA, YB));
+    }
+
+
+    /**
+     * Get number of photo-electrons.
+     *
+     * If the NPE tables have been compacted, the compacted NPE tables are used.
+     *
+     * \param  E                  muon energy at minimum distance of approach [GeV]
+     * \param  R                  minimum distance of approach [m]
+     * \param  theta              PMT zenith  angle [rad]
+     * \param  phi                PMT azimuth angle [rad]
+     * \return                    number of photo-electrons
+     */
+    double calculate(const double E,
+		     const double R,
+		     const double theta,
+		     const double phi) const
+    {
+      return calculate(std::atomic_load(&compacted).get(), E, R, theta, phi);
+    }
+
+
+    /**
+     * Get number of photo-electrons.
+     *
+     * Input arrays with a single element are broadcast to the size of the other input arrays.\n
+     * The evaluation is made without holding the Python global interpreter lock.
+     *
+     * \param  E                  muon energies at minimum distance of approach [GeV]
+     * \param  R                  minimum distances of approach [m]
+     * \param  theta              PMT zenith  angles [rad]
+     * \param  phi                PMT azimuth angles [rad]
+     * \param  out                output array or None
+     * \return                    numbers of photo-electrons
+     */
+    py::array_t<double> calculate(const array_type<double>& E,
+				  const array_type<double>& R,
+				  const array_type<double>& theta,
+				  const array_type<double>& phi,
+				  const py::object&         out) const
+    {
+      const std::shared_ptr<const JTables> tables = std::atomic_load(&compacted);
+
+      return vectorize<double>([this, &tables](const double E, const double R, const double theta, const double phi) {
+	  return this->calculate(tables.get(), E, R, theta, phi);
+	},
+	out,
+	JBroadcastArray<double>(E),
+	JBroadcastArray<double>(R),
+	JBroadcastArray<double>(theta),
+	JBroadcastArray<double>(phi));
+    }
+
+
+    /**
+     * Get number of photo-electrons using multiple threads.
+     *
+     * Input arrays with a single element are broadcast to the size of the other input arrays.\n
+     * The input arrays are split in chunks which are evaluated in parallel by a persistent pool of threads
+     * without holding the Python global interpreter lock.
+     *
+     * \param  E                  muon energies at minimum distance of approach [GeV]
+     * \param  R                  minimum distances of approach [m]
+     * \param  theta              PMT zenith  angles [rad]
+     * \param  phi                PMT azimuth angles [rad]
+     * \param  n_threads          number of threads (0 = number of hardware threads)
+     * \param  out                output array or None
+     * \return                    numbers of photo-electrons
+     */
+    py::array_t<double> calculateMany(const array_type<double>& E,
+				      const array_type<double>& R,
+				      const array_type<double>& theta,
+				      const array_type<double>& phi,
+				      const size_t              n_threads,
+				      const py::object&         out) const
+    {
+      const std::shared_ptr<const JTables> tables = std::atomic_load(&compacted);
+
+      return vectorize<double>([this, &tables](const double E, const double R, const double theta, const double phi) {
+	  return this->calculate(tables.get(), E, R, theta, phi);
+	},
+	out,
+	n_threads,
+	JBroadcastArray<double>(E),
+	JBroadcastArray<double>(R),
+	JBroadcastArray<double>(theta),
+	JBroadcastArray<double>(phi));
+    }
+
+  private:
+    typedef JppyCompactNPETable<double, double, JNPEMaplist_t>       JCompactNPE_t;
+
+
+    /**
+     * Compacted NPE tables.
+     */
+    struct JTables {
+      /**
+       * Constructor.
+       *
+       * \param  Y1             NPE tables for light from muon
+       * \param  YA             NPE tables for light from delta-rays
+       * \param  YB             NPE tables for light from EM showers
+       */
+      JTables(const std::vector<JNPE_t>& Y1,
+	      const std::vector<JNPE_t>& YA,
+	      const std::vector<JNPE_t>& YB) :
+	Y1(Y1.begin(), Y1.end()),
+	YA(YA.begin(), YA.end()),
+	YB(YB.begin(), YB.end())
+      {}
+
+      std::vector<JCompactNPE_t> Y1;     //!< light from muon
+      std::vector<JCompactNPE_t> YA;     //!< light from delta-rays
+      std::vector<JCompactNPE_t> YB;     //!< light from EM showers
+    };
+
+
+    /**
+     * Get number of photo-electrons.
+     *
+     * \param  tables             compacted NPE tables (NULL = original NPE tables)
+     * \param  E                  muon energy at minimum distance of approach [GeV]
+     * \param  R                  minimum distance of approach [m]
+     * \param  theta              PMT zenith  angle [rad]
+     * \param  phi                PMT azimuth angle [rad]
+     * \return                    number of photo-electrons
+     */
+    double calculate(const JTables* tables,
+		     const double   E,
+		     const double   R,
+		     const double   theta,
+		     const double   phi) const
+    {
+      if (tables != NULL)
+	return getNPE(tables->Y1, tables->YA, tables->YB, E, R, theta, phi);
+      else
+	return getNPE(Y1, YA, YB, E, R, theta, phi);
+    }
+
+    std::shared_ptr<const JTables> compacted;     //!< compacted NPE tables
+  };
+
+
+  /**
+   * Auxiliary data structure for shower NPE with vectorised evaluation.
+   */
+  struct JppyShowerNPE :
+    public JShowerNPE_t
+  {
+    /**
+     * Constructor.
+     *
+     * \param  fileDescriptor     PDF file descriptor
+     * \param  numberOfPoints     number of points for shower elongation
+     */
+    JppyShowerNPE(const std::string& fileDescriptor,
+		  const int          numberOfPoints = 0) :
+      JShowerNPE_t(fileDescriptor, numberOfPoints)
+    {}
+
+
+    using JShowerNPE_t::calculate;
+
+
+    /**
+     * Get number of photo-electrons.
+     *
+     * Input arrays with a single element are broadcast to the size of the other input arrays.\n
+     * The evaluation is made without holding the Python global interpreter lock.
+     *
+     * \param  E                  shower energies at minimum distance of approach [GeV]
+     * \param  D                  distances [m]
+     * \param  cd                 cosines of emission angle
+     * \param  theta              PMT zenith  angles [rad]
+     * \param  phi                PMT azimuth angles [rad]
+     * \param  out                output array or None
+     * \return                    numbers of photo-electrons
+     */
+    py::array_t<double> calculate(const array_type<double>& E,
+				  const array_type<double>& D,
+				  const array_type<double>& cd,
+				  const array_type<double>& theta,
+				  const array_type<double>& phi,
+				  const py::object&         out) const
+    {
+      return vectorize<double>([this](const double E, const double D, const double cd, const double theta, const double phi) {
+	  return this->JShowerNPE_t::calculate(E, D, cd, theta, phi);
+	},
+	out,
+	JBroadcastArray<double>(E),
+	JBroadcastArray<double>(D),
+	JBroadcastArray<double>(cd),
+	JBroadcastArray<double>(theta),
+	JBroadcastArray<double>(phi));
+    }
+
+
+    /**
+     * Get number of photo-electrons using multiple threads.
+     *
+     * Input arrays with a single element are broadcast to the size of the other input arrays.\n
+     * The input arrays are split in chunks which are evaluated in parallel by a persistent pool of threads
+     * without holding the Python global interpreter lock.
+     *
+     * \param  E                  shower energies at minimum distance of approach [GeV]
+     * \param  D                  distances [m]
+     * \param  cd                 cosines of emission angle
+     * \param  theta              PMT zenith  angles [rad]
+     * \param  phi                PMT azimuth angles [rad]
+     * \param  n_threads          number of threads (0 = number of hardware threads)
+     * \param  out                output array or None
+     * \return                    numbers of photo-electrons
+     */
+    py::array_t<double> calculateMany(const array_type<double>& E,
+				      const array_type<double>& D,
+				      const array_type<double>& cd,
+				      const array_type<double>& theta,
+				      const array_type<double>& phi,
+				      const size_t              n_threads,
+				      const py::object&         out) const
+    {
+      return vectorize<double>([this](const double E, const double D, const double cd, const double theta, const double phi) {
+	  return this->JShowerNPE_t::calculate(E, D, cd, theta, phi);
+	},
+	out,
+	n_threads,
+	JBroadcastArray<double>(E),
+	JBroadcastArray<double>(D),
+	JBroadcastArray<double>(cd),
+	JBroadcastArray<double>(theta),
+	JBroadcastArray<double>(phi));
+    }
+  };
+}
+
+#endif
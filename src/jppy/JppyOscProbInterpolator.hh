@@ -1,6 +1,7 @@
 #ifndef __JOSCPROB__JPPYOSCPROBINTERPOLATOR__
 #define __JOSCPROB__JPPYOSCPROBINTERPOLATOR__
 
+#include <algorithm>
 
 #include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
@@ -16,8 +17,13 @@
 
 #include "JOscProb/JOscChannel.hh"
 #include "JOscProb/JOscParameters.hh"
+#include "JOscProb/JOscParametersGrid.hh"
 #include "JOscProb/JOscProbInterpolator.hh"
 
+#include "utils.hh"
+#include "JppyThreadPool.hh"
+#include "JppyOscProbTable.hh"
+
 
 /**
  * \author bjung, jbootsma, mdejong
@@ -65,6 +71,9 @@ namespace JOSCPROB {
     typedef typename multifunction_type::super_iterator                                                super_iterator;
     typedef typename multifunction_type::function_type                                                  function_type;
 
+    typedef typename interpolator_type::slice_type                                                        slice_type;
+    typedef typename interpolator_type::gradient_type                                                  gradient_type;
+
     
     /**
      * Default constructor.
@@ -107,18 +116,10 @@ namespace JOSCPROB {
 				   const py::array_t<double>& E,
 				   const py::array_t<double>& costh) const {
 
-      using JLANG::JValueOutOfRange;
-
       py::buffer_info buffer1 = E.request();
       py::buffer_info buffer2 = costh.request();
 
-      if (buffer1.ndim != 1 || buffer2.ndim != 1) {
-	THROW(JValueOutOfRange, "JppyOscProbInterpolator<>::operator(): Input arrays are not one-dimensional.");
-      }
- 
-      if (buffer1.shape != buffer2.shape) {
-	THROW(JValueOutOfRange, "JppyOscProbInterpolator<>::operator(): Different input array shapes (" << buffer1.size << ", " << buffer2.size << ")");
-      }
+      check(buffer1, buffer2);
 
       py::array_t<double> result(buffer1.size);
       
@@ -155,6 +156,452 @@ namespace JOSCPROB {
       
       return (*this)(channel, E, costh);
     }
+
+
+    /**
+     * Get oscillation probabilities for all oscillation channels.
+     *
+     * The columns of the output array are ordered according to JOSCPROB::getOscChannel.\n
+     * Input arrays which are not contiguous or not of type double are converted (see UTILS::array_type).\n
+     * The evaluation is made without holding the Python global interpreter lock.
+     *
+     * \param  E                  neutrino energies [GeV], shape (n)
+     * \param  costh              cosine zenith angles, shape (n)
+     * \return                    oscillation probabilities, shape (n, NUMBER_OF_OSCCHANNELS)
+     */
+    py::array_t<double> getProbabilities(const UTILS::array_type<double>& E,
+					 const UTILS::array_type<double>& costh) const
+    {
+      py::buffer_info buffer1 = E.request();
+      py::buffer_info buffer2 = costh.request();
+
+      check(buffer1, buffer2);
+
+      const size_t n = buffer1.size;
+
+      py::array_t<double> result({ n, (size_t) NUMBER_OF_OSCCHANNELS });
+
+      const double* ptr1 = E.data();
+      const double* ptr2 = costh.data();
+      double*       ptr3 = result.mutable_data();
+
+      {
+	py::gil_scoped_release release;
+
+	for (size_t i = 0; i != n; ++i, ptr3 += NUMBER_OF_OSCCHANNELS) {
+
+	  const result_type probabilities = interpolator_type::getProbabilities(ptr1[i], ptr2[i]);
+
+	  std::copy(probabilities.begin(), probabilities.end(), ptr3);
+	}
+      }
+
+      return result;
+    }
+
+
+    /**
+     * Get oscillation probabilities for all oscillation channels\n
+     * for a given set of oscillation parameters.
+     *
+     * \param  parameters         oscillation parameters
+     * \param  E                  neutrino energies [GeV]
+     * \param  costh              cosine zenith angles
+     * \return                    oscillation probabilities, shape (n, NUMBER_OF_OSCCHANNELS)
+     */
+    py::array_t<double> getProbabilities(const JOscParameters&            parameters,
+					 const UTILS::array_type<double>& E,
+					 const UTILS::array_type<double>& costh)
+    {
+      this->set(parameters);
+
+      return getProbabilities(E, costh);
+    }
+
+    /**
+     * Get oscillation probabilities for oscillation channels given per event.
+     *
+     * The oscillation channels are resolved from the PDG identifiers and charge-parities (see JOSCPROB::getOscChannelIndex).\n
+     * Input arrays with a single element are broadcast to the size of the other input arrays.
+     * The evaluation is made in parallel without holding the Python global interpreter lock.
+     *
+     * \param  in                 PDG identifiers of incoming  neutrinos
+     * \param  out                PDG identifiers of outcoming neutrinos
+     * \param  Cparity            charge-parities (or PDG identifiers)
+     * \param  E                  neutrino energies [GeV]
+     * \param  costh              cosine zenith angles
+     * \param  n_threads          number of threads (0 = number of hardware threads)
+     * \param  result             output array or None
+     * \return                    oscillation probabilities
+     */
+    py::array_t<double> getChannelProbabilities(const UTILS::array_type<int>&    in,
+						const UTILS::array_type<int>&    out,
+						const UTILS::array_type<int>&    Cparity,
+						const UTILS::array_type<double>& E,
+						const UTILS::array_type<double>& costh,
+						const size_t                     n_threads,
+						const py::object&                result) const
+    {
+      return JOSCPROB::getChannelProbabilities(static_cast<const interpolator_type&>(*this), in, out, Cparity, E, costh, n_threads, result);
+    }
+
+
+    /**
+     * Get event weights.
+     *
+     * The weight of an event is the product of the given factor (e.g.\ cross section times exposure) and
+     * the sum over the incoming neutrino flavours of the flux times the oscillation probability to the outcoming neutrino flavour.\n
+     * The fluxes are ordered as electron, muon and tau neutrinos of the given charge-parity.
+     * Input arrays with a single element are broadcast to the size of the other input arrays.
+     * The evaluation is made in a single pass in parallel without holding the Python global interpreter lock.
+     *
+     * \param  flavour            PDG identifiers of outcoming neutrinos
+     * \param  Cparity            charge-parities (or PDG identifiers)
+     * \param  E                  neutrino energies [GeV]
+     * \param  costh              cosine zenith angles
+     * \param  flux               fluxes of incoming neutrinos, shape (n, 3)
+     * \param  factor             weight factors
+     * \param  n_threads          number of threads (0 = number of hardware threads)
+     * \param  result             output array or None
+     * \return                    weights
+     */
+    py::array_t<double> getWeights(const UTILS::array_type<int>&    flavour,
+				   const UTILS::array_type<int>&    Cparity,
+				   const UTILS::array_type<double>& E,
+				   const UTILS::array_type<double>& costh,
+				   const UTILS::array_type<double>& flux,
+				   const UTILS::array_type<double>& factor,
+				   const size_t                     n_threads,
+				   const py::object&                result) const
+    {
+      return JOSCPROB::getWeights(static_cast<const interpolator_type&>(*this), flavour, Cparity, E, costh, flux, factor, n_threads, result);
+    }
+
+
+    /**
+     * Get oscillation probabilities and their derivatives with respect to the oscillation parameters
+     * for a given oscillation channel.
+     *
+     * The derivatives are ordered as for method setFast (see JOscProbInterpolator::getProbabilities).\n
+     * The evaluation is made in parallel without holding the Python global interpreter lock.
+     *
+     * \param  channel            oscillation channel
+     * \param  E                  neutrino energies [GeV], shape (n)
+     * \param  costh              cosine zenith angles, shape (n)
+     * \param  n_threads          number of threads (0 = number of hardware threads)
+     * \return                    oscillation probabilities, shape (n), and derivatives, shape (n, 6)
+     */
+    py::tuple getGradient(const JOscChannel&               channel,
+			  const UTILS::array_type<double>& E,
+			  const UTILS::array_type<double>& costh,
+			  const size_t                     n_threads) const
+    {
+      using namespace std;
+      using namespace JPP;
+
+      py::buffer_info buffer1 = E.request();
+      py::buffer_info buffer2 = costh.request();
+
+      check(buffer1, buffer2);
+
+      const int index = getOscChannelIndex(channel);
+
+      if (index == -1) {
+	THROW(JValueOutOfRange, "JppyOscProbInterpolator<>::getGradient(): Invalid oscillation channel " << channel);
+      }
+
+      const size_t n = buffer1.size;
+
+      py::array_t<double> probabilities(n);
+      py::array_t<double> derivatives({ n, (size_t) NUMBER_OF_PARAMETERS });
+
+      const double* ptr1 = E.data();
+      const double* ptr2 = costh.data();
+      double*       ptr3 = probabilities.mutable_data();
+      double*       ptr4 = derivatives  .mutable_data();
+
+      {
+	py::gil_scoped_release release;
+
+	UTILS::getThreadPool().execute(n, n_threads, [&](const size_t begin, const size_t end) {
+
+	    gradient_type gradient;
+
+	    for (size_t i = begin; i != end; ++i) {
+
+	      ptr3[i] = interpolator_type::getProbabilities(ptr1[i], ptr2[i], gradient)[index];
+
+	      for (int k = 0; k != NUMBER_OF_PARAMETERS; ++k) {
+		ptr4[i * NUMBER_OF_PARAMETERS + k] = gradient[k][index];
+	      }
+	    }
+	  });
+      }
+
+      return py::make_tuple(probabilities, derivatives);
+    }
+
+
+    /**
+     * Set oscillation parameters for interpolation.
+     *
+     * The values should be ordered as <tt>dM21sq</tt>, <tt>dM31sq</tt>, <tt>deltaCP</tt>, <tt>sinsqTh12</tt>, <tt>sinsqTh13</tt> and <tt>sinsqTh23</tt>.
+     *
+     * \param  values             oscillation parameter values
+     */
+    void setFast(const UTILS::array_type<double>& values)
+    {
+      if (values.size() != NUMBER_OF_PARAMETERS) {
+	THROW(JValueOutOfRange, "JppyOscProbInterpolator<>::setFast(): Invalid number of oscillation parameter values " << values.size());
+      }
+
+      interpolator_type::set(values.data());
+    }
+
+
+    /**
+     * Get oscillation probabilities for a set of oscillation parameter values.
+     *
+     * The evaluation is made in parallel for the different oscillation parameter values
+     * without holding the Python global interpreter lock.\n
+     * For each oscillation parameter value, the interpolation table is first interpolated
+     * for all nodes in L/E and cosine zenith angle (see JOscProbInterpolator::freeze).
+     *
+     * \param  parameters         oscillation parameter values, shape (m, 6); ordered as for method setFast
+     * \param  E                  neutrino energies [GeV], shape (n)
+     * \param  costh              cosine zenith angles, shape (n)
+     * \param  channel            oscillation channel indices (see JOSCPROB::getOscChannel), shape (n)
+     * \param  n_threads          number of threads (0 = number of hardware threads)
+     * \return                    oscillation probabilities, shape (m, n)
+     */
+    py::array_t<double> evaluateGrid(const UTILS::array_type<double>& parameters,
+				     const UTILS::array_type<double>& E,
+				     const UTILS::array_type<double>& costh,
+				     const UTILS::array_type<int>&    channel,
+				     const size_t                     n_threads) const
+    {
+      py::buffer_info buffer0 = parameters.request();
+      py::buffer_info buffer1 = E.request();
+      py::buffer_info buffer2 = costh.request();
+      py::buffer_info buffer3 = channel.request();
+
+      if (buffer0.ndim != 2 || buffer0.shape[1] != NUMBER_OF_PARAMETERS) {
+	THROW(JValueOutOfRange, "JppyOscProbInterpolator<>::evaluateGrid(): Oscillation parameter values are not of shape (m, " << NUMBER_OF_PARAMETERS << ")");
+      }
+
+      check(buffer1, buffer2);
+      check(buffer1, buffer3);
+
+      const size_t m = buffer0.shape[0];
+      const size_t n = buffer1.size;
+
+      py::array_t<double> result({ m, n });
+
+      double* out = result.mutable_data();
+
+      {
+	py::gil_scoped_release release;
+
+	evaluateGrid(m, parameters.data(), n, E.data(), costh.data(), channel.data(), out, n_threads);
+      }
+
+      return result;
+    }
+
+
+    /**
+     * Get oscillation probabilities for a grid of oscillation parameters.
+     *
+     * The oscillation parameter values are ordered with the last parameter running fastest.\n
+     * Undefined oscillation parameters should correspond to fixed parameters of the interpolation table.\n
+     * This method is only available in C++;
+     * in Python, the oscillation parameter values of the grid are passed as an array of shape (m, 6).
+     *
+     * \param  grid               oscillation parameter grid
+     * \param  E                  neutrino energies [GeV], shape (n)
+     * \param  costh              cosine zenith angles, shape (n)
+     * \param  channel            oscillation channel indices (see JOSCPROB::getOscChannel), shape (n)
+     * \param  n_threads          number of threads (0 = number of hardware threads)
+     * \return                    oscillation probabilities, shape (m, n)
+     */
+    py::array_t<double> evaluateGrid(const JOscParametersGrid&        grid,
+				     const UTILS::array_type<double>& E,
+				     const UTILS::array_type<double>& costh,
+				     const UTILS::array_type<int>&    channel,
+				     const size_t                     n_threads) const
+    {
+      using namespace std;
+      using namespace JPP;
+
+      const JOscParametersGrid::JParameter_t* const parameters[] = { &grid.dM21sq,
+								      &grid.dM31sq,
+								      &grid.deltaCP,
+								      &grid.sinsqTh12,
+								      &grid.sinsqTh13,
+								      &grid.sinsqTh23 };
+
+      const JOscParameters::JParameter_t* const fixed[] = { &this->getTableParameters().dM21sq,
+							     &this->getTableParameters().dM31sq,
+							     &this->getTableParameters().deltaCP,
+							     &this->getTableParameters().sinsqTh12,
+							     &this->getTableParameters().sinsqTh13,
+							     &this->getTableParameters().sinsqTh23 };
+
+      size_t m = 1;
+
+      for (int i = 0; i != NUMBER_OF_PARAMETERS; ++i) {
+
+	if (parameters[i]->isDefined()) {
+	  m *= parameters[i]->getValue().getSize();
+	} else if (!fixed[i]->isDefined()) {
+	  THROW(JNoValue, "JppyOscProbInterpolator<>::evaluateGrid(): No value for oscillation parameter " << i);
+	}
+      }
+
+      py::array_t<double> values({ m, (size_t) NUMBER_OF_PARAMETERS });
+
+      double* p = values.mutable_data();
+
+      for (size_t k = 0; k != m; ++k) {
+
+	size_t j = k;
+
+	for (int i = NUMBER_OF_PARAMETERS - 1; i >= 0; --i) {
+
+	  if (parameters[i]->isDefined()) {
+
+	    const JGrid<double>& x = parameters[i]->getValue();
+
+	    p[k * NUMBER_OF_PARAMETERS + i] = x.getX(j % x.getSize());
+
+	    j /= x.getSize();
+
+	  } else {
+
+	    p[k * NUMBER_OF_PARAMETERS + i] = 0.0;
+	  }
+	}
+      }
+
+      return evaluateGrid(values, E, costh, channel, n_threads);
+    }
+
+
+    /**
+     * Store this oscillation probability table in a POSIX shared memory object.
+     *
+     * \param  name               name of shared memory object
+     */
+    void toShared(const char* name) const
+    {
+      JppyOscProbTable::share(*this, name);
+    }
+
+
+    /**
+     * Attach read-only to an oscillation probability table in a POSIX shared memory object.
+     *
+     * The shared memory object should have been created with method toShared.
+     *
+     * \param  name               name of shared memory object
+     * \return                    oscillation probability table
+     */
+    static JppyOscProbTable fromShared(const char* name)
+    {
+      return JppyOscProbTable::fromShared(name);
+    }
+
+
+    static const int NUMBER_OF_PARAMETERS = interpolator_type::NUMBER_OF_PARAMETERS;     //!< number of oscillation parameters
+
+  private:
+    /**
+     * Get oscillation probabilities for a set of oscillation parameter values.
+     *
+     * \param  m                  number of oscillation parameter values
+     * \param  parameters         oscillation parameter values
+     * \param  n                  number of events
+     * \param  E                  neutrino energies [GeV]
+     * \param  costh              cosine zenith angles
+     * \param  channel            oscillation channel indices
+     * \param  out                oscillation probabilities
+     * \param  n_threads          number of threads (0 = number of hardware threads)
+     */
+    void evaluateGrid(const size_t  m,
+		      const double* parameters,
+		      const size_t  n,
+		      const double* E,
+		      const double* costh,
+		      const int*    channel,
+		      double*       out,
+		      const size_t  n_threads) const
+    {
+      using namespace std;
+      using namespace JPP;
+
+      vector<double> x(n);
+
+      this->getBaselineCalculator().getBaseline(n, costh, x.data());
+
+      for (size_t i = 0; i != n; ++i) {
+
+	if (channel[i] < 0 || channel[i] >= (int) NUMBER_OF_OSCCHANNELS) {
+	  THROW(JValueOutOfRange, "JppyOscProbInterpolator<>::evaluateGrid(): Invalid oscillation channel index " << channel[i]);
+	}
+
+	x[i] /= E[i];
+      }
+
+      UTILS::getThreadPool().execute(m, n_threads, [&](const size_t begin, const size_t end) {
+
+	  slice_type slice(this->getLayout());
+
+	  JArray<NUMBER_OF_DIMENSIONS, argument_type> point;
+
+	  for (size_t k = begin; k != end; ++k) {
+
+	    double* const p = out + k * n;
+
+	    this->getParameterValues(parameters + k * NUMBER_OF_PARAMETERS, point.data());
+
+	    if (this->getSlice(point.data(), slice)) {
+
+	      for (size_t i = 0; i != n; ++i) {
+		p[i] = slice(x[i], costh[i])[channel[i]];
+	      }
+
+	    } else {
+
+	      for (size_t i = 0; i != n; ++i) {
+
+		point[NUMBER_OF_DIMENSIONS-2] = x[i];
+		point[NUMBER_OF_DIMENSIONS-1] = costh[i];
+
+		p[i] = this->evaluate(point.data())[channel[i]];
+	      }
+	    }
+	  }
+	}, 1);
+    }
+
+
+    /**
+     * Check input arrays.
+     *
+     * \param  buffer1            energies
+     * \param  buffer2            cosine zenith angles
+     */
+    static void check(const py::buffer_info& buffer1,
+		      const py::buffer_info& buffer2)
+    {
+      if (buffer1.ndim != 1 || buffer2.ndim != 1) {
+	THROW(JValueOutOfRange, "JppyOscProbInterpolator<>: Input arrays are not one-dimensional.");
+      }
+ 
+      if (buffer1.shape != buffer2.shape) {
+	THROW(JValueOutOfRange, "JppyOscProbInterpolator<>: Different input array shapes (" << buffer1.size << ", " << buffer2.size << ")");
+      }
+    }
   };
 }
 
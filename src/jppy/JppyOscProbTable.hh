@@ -0,0 +1,1072 @@
+#ifndef __JOSCPROB__JPPYOSCPROBTABLE__
+#define __JOSCPROB__JPPYOSCPROBTABLE__
+
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include <fstream>
+#include <algorithm>
+#include <type_traits>
+
+#include "JLang/JException.hh"
+#include "JLang/JSharedPointer.hh"
+
+#include "JTools/JArray.hh"
+#include "JTools/JDistance.hh"
+#include "JTools/JPolint.hh"
+#include "JTools/JGridCollection.hh"
+
+#include "JOscProb/JOscChannel.hh"
+#include "JOscProb/JOscParameters.hh"
+#include "JOscProb/JBaselineCalculator.hh"
+#include "JOscProb/JOscProbInterpolator.hh"
+
+#include "utils.hh"
+#include "JppyThreadPool.hh"
+#include "JppyCompactTable.hh"
+#include "JppyMemoryMap.hh"
+
+
+/**
+ * \file
+ *
+ * Memory-mapped read-only oscillation probability table.
+ */
+
+namespace JOSCPROB {}
+namespace JPP { using namespace JOSCPROB; }
+
+namespace JOSCPROB {
+
+  using JLANG::JValueOutOfRange;
+  using JLANG::JFunctionalException;
+  using JLANG::JFileOpenException;
+  using JLANG::JFileReadException;
+  using JLANG::JNoValue;
+
+  namespace py = pybind11;
+
+
+  /**
+   * Header of memory-mapped oscillation probability table.
+   *
+   * The header is followed by the index and abscissa arrays of each dimension and the array of oscillation probabilities.\n
+   * The number of maps (or functions) of a dimension is equal to the number of abscissa values of the previous dimension
+   * (one for the first dimension).
+   * The index array of a dimension holds the offset of each map in the abscissa array of this dimension, followed by the total number of abscissa values.
+   * The oscillation probabilities of all channels are stored consecutively for each abscissa value of the last dimension.
+   * All offsets are in bytes from the begin of the file and all data are stored in the native byte order.
+   */
+  struct JppyOscProbTableHeader {
+
+    enum { NUMBER_OF_DIMENSIONS = 8 };
+    enum { NUMBER_OF_PARAMETERS = 6 };
+
+    static const uint64_t VERSION   = 1;                  //!< format version
+    static const size_t   ALIGNMENT = 64;                 //!< alignment of arrays [B]
+
+
+    /**
+     * Get file identifier.
+     *
+     * \return                    file identifier
+     */
+    static const char* getMagic()
+    {
+      return "JPPYOSC";
+    }
+
+
+    char     magic     [8];                               //!< file identifier
+    uint64_t version;                                     //!< format version
+    uint64_t numberOfChannels;                            //!< number of oscillation channels
+    uint64_t fileSize;                                    //!< size of file [B]
+    int64_t  degree    [NUMBER_OF_DIMENSIONS];            //!< degree of interpolation polynomial
+    int64_t  grid      [NUMBER_OF_DIMENSIONS];            //!< grid option
+    uint64_t size      [NUMBER_OF_DIMENSIONS];            //!< number of abscissa values
+    uint64_t index     [NUMBER_OF_DIMENSIONS];            //!< offset of index array
+    uint64_t abscissa  [NUMBER_OF_DIMENSIONS];            //!< offset of abscissa values
+    uint64_t ordinate;                                    //!< offset of oscillation probabilities
+    uint64_t defined   [NUMBER_OF_PARAMETERS];            //!< fixed oscillation parameters
+    double   parameters[NUMBER_OF_PARAMETERS];            //!< values of fixed oscillation parameters
+    double   Lmin;                                        //!< minimum baseline [km]
+    double   Lmax;                                        //!< maximum baseline [km]
+  };
+
+
+  /**
+   * Get interpolation method of one-dimensional function.
+   *
+   * \param  degree             pointer to output degree of polynomial
+   * \param  grid               pointer to output grid option
+   * \param  function           function
+   */
+  template<unsigned int N, class JElement_t, template<class, class> class JCollection_t, class JResult_t, class JDistance_t>
+  inline void getCompactFunction(int* degree, bool* grid, const JTOOLS::JPolintFunction1D<N, JElement_t, JCollection_t, JResult_t, JDistance_t>*)
+  {
+    *degree = N;
+    *grid   = std::is_same<JCollection_t<JElement_t, JDistance_t>, JTOOLS::JGridCollection<JElement_t, JDistance_t> >::value;
+  }
+
+
+  /**
+   * Get oscillation probabilities for oscillation channels given per event.
+   *
+   * The oscillation probability function should provide the method <tt>getProbabilities(E, costh)</tt>
+   * which returns the oscillation probabilities of all oscillation channels.\n
+   * The oscillation channels are resolved from the PDG identifiers and charge-parities (see JOSCPROB::getOscChannelIndex).\n
+   * Input arrays with a single element are broadcast to the size of the other input arrays.
+   * The evaluation is made in parallel without holding the Python global interpreter lock.
+   *
+   * \param  function           oscillation probability function
+   * \param  in                 PDG identifiers of incoming  neutrinos
+   * \param  out                PDG identifiers of outcoming neutrinos
+   * \param  Cparity            charge-parities (or PDG identifiers)
+   * \param  E                  neutrino energies [GeV]
+   * \param  costh              cosine zenith angles
+   * \param  n_threads          number of threads (0 = number of hardware threads)
+   * \param  result             output array or None
+   * \return                    oscillation probabilities
+   */
+  template<class JOscProbFunction_t>
+  inline py::array_t<double> getChannelProbabilities(const JOscProbFunction_t&        function,
+						     const UTILS::array_type<int>&    in,
+						     const UTILS::array_type<int>&    out,
+						     const UTILS::array_type<int>&    Cparity,
+						     const UTILS::array_type<double>& E,
+						     const UTILS::array_type<double>& costh,
+						     const size_t                     n_threads,
+						     const py::object&                result)
+  {
+    return UTILS::vectorize<double>([&function](const int in, const int out, const int Cparity, const double E, const double costh) {
+
+	const int index = getOscChannelIndex(in, out, Cparity);
+
+	if (index == -1) {
+	  THROW(JValueOutOfRange, "getChannelProbabilities(): Invalid oscillation channel " << in << ' ' << out << ' ' << Cparity);
+	}
+
+	return function.getProbabilities(E, costh)[index];
+      },
+      result,
+      n_threads,
+      UTILS::JBroadcastArray<int>   (in),
+      UTILS::JBroadcastArray<int>   (out),
+      UTILS::JBroadcastArray<int>   (Cparity),
+      UTILS::JBroadcastArray<double>(E),
+      UTILS::JBroadcastArray<double>(costh));
+  }
+
+
+  /**
+   * Get event weights.
+   *
+   * The oscillation probability function should provide the method <tt>getProbabilities(E, costh)</tt>
+   * which returns the oscillation probabilities of all oscillation channels.\n
+   * The weight of an event is the product of the given factor (e.g.\ cross section times exposure) and
+   * the sum over the incoming neutrino flavours of the flux times the oscillation probability to the outcoming neutrino flavour.\n
+   * The fluxes are ordered as electron, muon and tau neutrinos of the given charge-parity.
+   * Input arrays with a single element are broadcast to the size of the other input arrays.
+   * The evaluation is made in a single pass in parallel without holding the Python global interpreter lock.
+   *
+   * \param  function           oscillation probability function
+   * \param  flavour            PDG identifiers of outcoming neutrinos
+   * \param  Cparity            charge-parities (or PDG identifiers)
+   * \param  E                  neutrino energies [GeV]
+   * \param  costh              cosine zenith angles
+   * \param  flux               fluxes of incoming neutrinos, shape (n, 3)
+   * \param  factor             weight factors
+   * \param  n_threads          number of threads (0 = number of hardware threads)
+   * \param  result             output array or None
+   * \return                    weights
+   */
+  template<class JOscProbFunction_t>
+  inline py::array_t<double> getWeights(const JOscProbFunction_t&        function,
+					const UTILS::array_type<int>&    flavour,
+					const UTILS::array_type<int>&    Cparity,
+					const UTILS::array_type<double>& E,
+					const UTILS::array_type<double>& costh,
+					const UTILS::array_type<double>& flux,
+					const UTILS::array_type<double>& factor,
+					const size_t                     n_threads,
+					const py::object&                result)
+  {
+    static const int flavours[] = { (int) JFlavour_t::ELECTRON,
+				    (int) JFlavour_t::MUON,
+				    (int) JFlavour_t::TAU };
+
+    static const int N = sizeof(flavours) / sizeof(flavours[0]);
+
+    const UTILS::JBroadcastArray<int>    out   (flavour);
+    const UTILS::JBroadcastArray<int>    C     (Cparity);
+    const UTILS::JBroadcastArray<double> x     (E);
+    const UTILS::JBroadcastArray<double> y     (costh);
+    const UTILS::JBroadcastArray<double> weight(factor);
+
+    const size_t n = UTILS::getBroadcastSize(out, C, x, y, weight);
+
+    if (flux.ndim() != 2 || flux.shape(1) != N || (flux.shape(0) != 1 && (size_t) flux.shape(0) != n)) {
+      THROW(JValueOutOfRange, "getWeights(): Fluxes are not of shape (" << n << ", " << N << ")");
+    }
+
+    const double* const phi  = flux.data();
+    const size_t        step = (flux.shape(0) == 1 ? 0 : N);
+
+    py::array_t<double> weights = UTILS::getOutputArray<double>(result, n);
+
+    double* const p = weights.mutable_data();
+
+    {
+      py::gil_scoped_release release;
+
+      UTILS::getThreadPool().execute(n, n_threads, [&](const size_t begin, const size_t end) {
+
+	  for (size_t i = begin; i != end; ++i) {
+
+	    const auto probabilities = function.getProbabilities(x[i], y[i]);
+
+	    double w = 0.0;
+
+	    for (int j = 0; j != N; ++j) {
+
+	      const int index = getOscChannelIndex(flavours[j], out[i], C[i]);
+
+	      if (index == -1) {
+		THROW(JValueOutOfRange, "getWeights(): Invalid oscillation channel " << flavours[j] << ' ' << out[i] << ' ' << C[i]);
+	      }
+
+	      w += phi[i * step + j] * probabilities[index];
+	    }
+
+	    p[i] = weight[i] * w;
+	  }
+	});
+    }
+
+    return weights;
+  }
+
+
+  /**
+   * Memory-mapped read-only oscillation probability table.
+   *
+   * The table is evaluated in place, i.e.\ without reading and compiling the complete table.
+   * All processes which use the same file share the same memory.
+   * The oscillation probabilities are identical to those of the original oscillation probability table (i.e.\ JOSCPROB::JOscProbInterpolator).
+   */
+  class JppyOscProbTable {
+  public:
+
+    enum { NUMBER_OF_DIMENSIONS = JppyOscProbTableHeader::NUMBER_OF_DIMENSIONS };
+    enum { NUMBER_OF_PARAMETERS = JppyOscProbTableHeader::NUMBER_OF_PARAMETERS };
+
+    typedef double                                                  argument_type;
+    typedef JTOOLS::JArray<NUMBER_OF_OSCCHANNELS, double>           result_type;
+    typedef JTOOLS::JDistance<argument_type>                        distance_type;
+
+    static const int MAXIMAL_DEGREE = 3;
+
+
+    /**
+     * Constructor.
+     *
+     * \param  fileName           file name of memory-mapped oscillation probability table
+     */
+    JppyOscProbTable(const char* fileName) :
+      memory(new UTILS::JppyMemoryMap(fileName))
+    {
+      configure(fileName);
+    }
+
+
+    /**
+     * Store oscillation probability table in memory-mappable format.
+     *
+     * \param  input              oscillation probability table
+     * \param  fileName           file name
+     */
+    template<template<class, class> class JCollection_t, class JFunction1D_t, class JFunctionalMaplist_t>
+    static void store(const JOscProbInterpolator<JCollection_t, JFunction1D_t, JFunctionalMaplist_t>& input,
+		      const char*                                                                      fileName)
+    {
+      using namespace std;
+
+      const vector<char> buffer = getImage(input);
+
+      ofstream out(fileName, ios::binary);
+
+      if (!out) {
+	THROW(JFileOpenException, "JppyOscProbTable::store(): Error opening file " << fileName);
+      }
+
+      out.write(buffer.data(), buffer.size());
+      out.close();
+
+      if (!out) {
+	THROW(JFileOpenException, "JppyOscProbTable::store(): Error writing file " << fileName);
+      }
+    }
+
+
+    /**
+     * Store oscillation probability table in POSIX shared memory object.
+     *
+     * The shared memory object should not yet exist.
+     * It persists until it is removed (see method unlink), also after the creating process has terminated.
+     * Other processes should attach to the shared memory object only after this method has returned (see method fromShared).
+     *
+     * \param  input              oscillation probability table
+     * \param  name               name of shared memory object
+     */
+    template<template<class, class> class JCollection_t, class JFunction1D_t, class JFunctionalMaplist_t>
+    static void share(const JOscProbInterpolator<JCollection_t, JFunction1D_t, JFunctionalMaplist_t>& input,
+		      const char*                                                                      name)
+    {
+      const std::vector<char> buffer = getImage(input);
+
+      UTILS::JppySharedMemory::create(name, buffer.data(), buffer.size());
+    }
+
+
+    /**
+     * Attach read-only to oscillation probability table in POSIX shared memory object.
+     *
+     * \param  name               name of shared memory object
+     * \return                    oscillation probability table
+     */
+    static JppyOscProbTable fromShared(const char* name)
+    {
+      return JppyOscProbTable(new UTILS::JppySharedMemory(name), name);
+    }
+
+
+    /**
+     * Remove POSIX shared memory object.
+     *
+     * Processes which are attached to the shared memory object can continue to use it.
+     *
+     * \param  name               name of shared memory object
+     */
+    static void unlink(const char* name)
+    {
+      UTILS::JppySharedMemory::unlink(name);
+    }
+
+
+    /**
+     * Get oscillation probability table in memory-mappable format.
+     *
+     * \param  input              oscillation probability table
+     * \return                    data
+     */
+    template<template<class, class> class JCollection_t, class JFunction1D_t, class JFunctionalMaplist_t>
+    static std::vector<char> getImage(const JOscProbInterpolator<JCollection_t, JFunction1D_t, JFunctionalMaplist_t>& input)
+    {
+      using namespace std;
+      using namespace JPP;
+
+      static_assert(JOscProbInterpolator<JCollection_t, JFunction1D_t, JFunctionalMaplist_t>::NUMBER_OF_DIMENSIONS == (int) NUMBER_OF_DIMENSIONS,
+		    "Invalid number of dimensions of oscillation probability table");
+
+      JppyOscProbTableHeader header;
+
+      memset(&header, 0, sizeof(header));
+
+      strncpy(header.magic, JppyOscProbTableHeader::getMagic(), sizeof(header.magic));
+
+      header.version          = JppyOscProbTableHeader::VERSION;
+      header.numberOfChannels = NUMBER_OF_OSCCHANNELS;
+
+      int  degree[NUMBER_OF_DIMENSIONS];
+      bool grid  [NUMBER_OF_DIMENSIONS];
+
+      getCompactMaps    (degree, grid, (JFunctionalMaplist_t*) NULL);
+      getCompactFunction(degree + NUMBER_OF_DIMENSIONS - 1, grid + NUMBER_OF_DIMENSIONS - 1, (JFunction1D_t*) NULL);
+
+      vector<uint64_t> index   [NUMBER_OF_DIMENSIONS];
+      vector<double>   abscissa[NUMBER_OF_DIMENSIONS];
+      vector<double>   ordinate;
+
+      for (int i = 0; i != NUMBER_OF_DIMENSIONS; ++i) {
+
+	if (degree[i] > MAXIMAL_DEGREE) {
+	  THROW(JValueOutOfRange, "JppyOscProbTable::getImage(): Invalid degree of interpolation polynomial " << degree[i]);
+	}
+
+	header.degree[i] = degree[i];
+	header.grid  [i] = grid  [i];
+
+	index[i].push_back(0);
+      }
+
+      put(input, index, abscissa, ordinate, std::integral_constant<int, 0>());
+
+      const JOscParameters::JParameter_t* const fixed[] = { &input.getTableParameters().dM21sq,
+							     &input.getTableParameters().dM31sq,
+							     &input.getTableParameters().deltaCP,
+							     &input.getTableParameters().sinsqTh12,
+							     &input.getTableParameters().sinsqTh13,
+							     &input.getTableParameters().sinsqTh23 };
+
+      for (int i = 0; i != NUMBER_OF_PARAMETERS; ++i) {
+
+	header.defined[i] = fixed[i]->isDefined();
+
+	if (fixed[i]->isDefined()) {
+	  header.parameters[i] = fixed[i]->getValue();
+	}
+      }
+
+      header.Lmin = input.getBaselineCalculator().getMinimumBaseline();
+      header.Lmax = input.getBaselineCalculator().getMaximumBaseline();
+
+      uint64_t pos = getAligned(sizeof(header));
+
+      for (int i = 0; i != NUMBER_OF_DIMENSIONS; ++i) {
+
+	header.size    [i] = abscissa[i].size();
+	header.index   [i] = pos;  pos = getAligned(pos + index   [i].size() * sizeof(uint64_t));
+	header.abscissa[i] = pos;  pos = getAligned(pos + abscissa[i].size() * sizeof(double));
+      }
+
+      header.ordinate = pos;
+      header.fileSize = pos + ordinate.size() * sizeof(double);
+
+      vector<char> buffer(header.fileSize, '\0');
+
+      copy(&header, sizeof(header), buffer, 0);
+
+      for (int i = 0; i != NUMBER_OF_DIMENSIONS; ++i) {
+	copy(index   [i].data(), index   [i].size() * sizeof(uint64_t), buffer, header.index   [i]);
+	copy(abscissa[i].data(), abscissa[i].size() * sizeof(double),   buffer, header.abscissa[i]);
+      }
+
+      copy(ordinate.data(), ordinate.size() * sizeof(double), buffer, header.ordinate);
+
+      return buffer;
+    }
+
+
+    /**
+     * Get fixed oscillation parameters associated with this interpolation table.
+     *
+     * \return                    oscillation parameters
+     */
+    const JOscParameters& getTableParameters() const
+    {
+      return parameters;
+    }
+
+
+    /**
+     * Get baseline calculator associated with this interpolation table.
+     *
+     * \return                    baseline calculator
+     */
+    const JBaselineCalculator& getBaselineCalculator() const
+    {
+      return getBaseline;
+    }
+
+
+    /**
+     * Set oscillation parameters for interpolation.
+     *
+     * \param  parameters         oscillation parameters
+     */
+    void set(JOscParameters parameters)
+    {
+      using namespace JPP;
+
+      parameters.join(this->parameters);
+
+      const JOscParameters::JParameter_t* const values[] = { &parameters.dM21sq,
+							      &parameters.dM31sq,
+							      &parameters.deltaCP,
+							      &parameters.sinsqTh12,
+							      &parameters.sinsqTh13,
+							      &parameters.sinsqTh23 };
+
+      for (int i = 0; i != NUMBER_OF_PARAMETERS; ++i) {
+
+	if (!values[i]->isDefined()) {
+	  THROW(JNoValue, "JppyOscProbTable::set(JOscParameters): No value for oscillation parameter " << i);
+	}
+
+	buffer[i] = values[i]->getValue();
+      }
+    }
+
+
+    /**
+     * Set oscillation parameters for interpolation.
+     *
+     * The values should be ordered as <tt>dM21sq</tt>, <tt>dM31sq</tt>, <tt>deltaCP</tt>, <tt>sinsqTh12</tt>, <tt>sinsqTh13</tt> and <tt>sinsqTh23</tt>.
+     * The fixed oscillation parameters of this interpolation table take precedence over the given values.
+     *
+     * \param  values             oscillation parameter values
+     */
+    void set(const double* values)
+    {
+      for (int i = 0; i != NUMBER_OF_PARAMETERS; ++i) {
+	buffer[i] = (header->defined[i] ? header->parameters[i] : values[i]);
+      }
+    }
+
+
+    /**
+     * Get oscillation probabilities for all oscillation channels.
+     *
+     * The oscillation probabilities are ordered according to JOSCPROB::getOscChannel.
+     *
+     * \param  E                  neutrino energy [GeV]
+     * \param  costh              cosine zenith angle
+     * \return                    oscillation probabilities
+     */
+    result_type getProbabilities(const double E,
+				 const double costh) const
+    {
+      JTOOLS::JArray<NUMBER_OF_DIMENSIONS, argument_type> point(buffer);
+
+      point[NUMBER_OF_DIMENSIONS-2] = getBaseline(costh) / E;
+      point[NUMBER_OF_DIMENSIONS-1] = costh;
+
+      return evaluate(0, 0, point.data());
+    }
+
+
+    /**
+     * Get oscillation probabilities for all oscillation channels.
+     *
+     * The columns of the output array are ordered according to JOSCPROB::getOscChannel.\n
+     * The evaluation is made in parallel without holding the Python global interpreter lock.
+     *
+     * \param  E                  neutrino energies [GeV], shape (n)
+     * \param  costh              cosine zenith angles, shape (n)
+     * \param  n_threads          number of threads (0 = number of hardware threads)
+     * \return                    oscillation probabilities, shape (n, NUMBER_OF_OSCCHANNELS)
+     */
+    py::array_t<double> getProbabilities(const UTILS::array_type<double>& E,
+					 const UTILS::array_type<double>& costh,
+					 const size_t                     n_threads) const
+    {
+      if (E.ndim() != 1 || costh.ndim() != 1 || E.size() != costh.size()) {
+	THROW(JValueOutOfRange, "JppyOscProbTable::getProbabilities(): Input arrays are not one-dimensional or have different sizes.");
+      }
+
+      const size_t n = E.size();
+
+      py::array_t<double> result({ n, (size_t) NUMBER_OF_OSCCHANNELS });
+
+      const double* ptr1 = E.data();
+      const double* ptr2 = costh.data();
+      double*       ptr3 = result.mutable_data();
+
+      {
+	py::gil_scoped_release release;
+
+	UTILS::getThreadPool().execute(n, n_threads, [&](const size_t begin, const size_t end) {
+	    for (size_t i = begin; i != end; ++i) {
+
+	      const result_type probabilities = getProbabilities(ptr1[i], ptr2[i]);
+
+	      std::copy(probabilities.begin(), probabilities.end(), ptr3 + i * NUMBER_OF_OSCCHANNELS);
+	    }
+	  });
+      }
+
+      return result;
+    }
+
+
+    /**
+     * Get oscillation probabilities for a given oscillation channel.
+     *
+     * The evaluation is made in parallel without holding the Python global interpreter lock.
+     *
+     * \param  channel            oscillation channel
+     * \param  E                  neutrino energies [GeV], shape (n)
+     * \param  costh              cosine zenith angles, shape (n)
+     * \param  n_threads          number of threads (0 = number of hardware threads)
+     * \return                    oscillation probabilities, shape (n)
+     */
+    py::array_t<double> operator()(const JOscChannel&               channel,
+				   const UTILS::array_type<double>& E,
+				   const UTILS::array_type<double>& costh,
+				   const size_t                     n_threads) const
+    {
+      using namespace JPP;
+
+      if (E.ndim() != 1 || costh.ndim() != 1 || E.size() != costh.size()) {
+	THROW(JValueOutOfRange, "JppyOscProbTable::operator(): Input arrays are not one-dimensional or have different sizes.");
+      }
+
+      const int index = getOscChannelIndex(channel);
+
+      if (index == -1) {
+	THROW(JValueOutOfRange, "JppyOscProbTable::operator(): Invalid oscillation channel " << channel);
+      }
+
+      return UTILS::vectorize<double>([this, index](const double E, const double costh) {
+	  return getProbabilities(E, costh)[index];
+	},
+	py::none(),
+	n_threads,
+	UTILS::JBroadcastArray<double>(E),
+	UTILS::JBroadcastArray<double>(costh));
+    }
+
+
+    /**
+     * Get oscillation probabilities for a given set of oscillation parameters\n
+     * and a given oscillation channel.
+     *
+     * \param  parameters         oscillation parameters
+     * \param  channel            oscillation channel
+     * \param  E                  neutrino energies [GeV], shape (n)
+     * \param  costh              cosine zenith angles, shape (n)
+     * \param  n_threads          number of threads (0 = number of hardware threads)
+     * \return                    oscillation probabilities, shape (n)
+     */
+    py::array_t<double> operator()(const JOscParameters&            parameters,
+				   const JOscChannel&               channel,
+				   const UTILS::array_type<double>& E,
+				   const UTILS::array_type<double>& costh,
+				   const size_t                     n_threads)
+    {
+      set(parameters);
+
+      return (*this)(channel, E, costh, n_threads);
+    }
+
+
+    /**
+     * Get oscillation probabilities for oscillation channels given per event.
+     *
+     * See JOSCPROB::getChannelProbabilities.
+     *
+     * \param  in                 PDG identifiers of incoming  neutrinos
+     * \param  out                PDG identifiers of outcoming neutrinos
+     * \param  Cparity            charge-parities (or PDG identifiers)
+     * \param  E                  neutrino energies [GeV]
+     * \param  costh              cosine zenith angles
+     * \param  n_threads          number of threads (0 = number of hardware threads)
+     * \param  result             output array or None
+     * \return                    oscillation probabilities
+     */
+    py::array_t<double> getChannelProbabilities(const UTILS::array_type<int>&    in,
+						const UTILS::array_type<int>&    out,
+						const UTILS::array_type<int>&    Cparity,
+						const UTILS::array_type<double>& E,
+						const UTILS::array_type<double>& costh,
+						const size_t                     n_threads,
+						const py::object&                result) const
+    {
+      return JOSCPROB::getChannelProbabilities(*this, in, out, Cparity, E, costh, n_threads, result);
+    }
+
+
+    /**
+     * Get event weights.
+     *
+     * See JOSCPROB::getWeights.
+     *
+     * \param  flavour            PDG identifiers of outcoming neutrinos
+     * \param  Cparity            charge-parities (or PDG identifiers)
+     * \param  E                  neutrino energies [GeV]
+     * \param  costh              cosine zenith angles
+     * \param  flux               fluxes of incoming neutrinos, shape (n, 3)
+     * \param  factor             weight factors
+     * \param  n_threads          number of threads (0 = number of hardware threads)
+     * \param  result             output array or None
+     * \return                    weights
+     */
+    py::array_t<double> getWeights(const UTILS::array_type<int>&    flavour,
+				   const UTILS::array_type<int>&    Cparity,
+				   const UTILS::array_type<double>& E,
+				   const UTILS::array_type<double>& costh,
+				   const UTILS::array_type<double>& flux,
+				   const UTILS::array_type<double>& factor,
+				   const size_t                     n_threads,
+				   const py::object&                result) const
+    {
+      return JOSCPROB::getWeights(*this, flavour, Cparity, E, costh, flux, factor, n_threads, result);
+    }
+
+
+    /**
+     * Get oscillation probabilities for a set of oscillation parameter values.
+     *
+     * The evaluation is made in parallel for the different oscillation parameter values
+     * without holding the Python global interpreter lock.\n
+     * The fixed oscillation parameters of this interpolation table take precedence over the given values.
+     *
+     * \param  parameters         oscillation parameter values, shape (m, 6); ordered as for method set(const double*)
+     * \param  E                  neutrino energies [GeV], shape (n)
+     * \param  costh              cosine zenith angles, shape (n)
+     * \param  channel            oscillation channel indices (see JOSCPROB::getOscChannel), shape (n)
+     * \param  n_threads          number of threads (0 = number of hardware threads)
+     * \return                    oscillation probabilities, shape (m, n)
+     */
+    py::array_t<double> evaluateGrid(const UTILS::array_type<double>& parameters,
+				     const UTILS::array_type<double>& E,
+				     const UTILS::array_type<double>& costh,
+				     const UTILS::array_type<int>&    channel,
+				     const size_t                     n_threads) const
+    {
+      using namespace std;
+      using namespace JPP;
+
+      if (parameters.ndim() != 2 || parameters.shape(1) != NUMBER_OF_PARAMETERS) {
+	THROW(JValueOutOfRange, "JppyOscProbTable::evaluateGrid(): Oscillation parameter values are not of shape (m, " << NUMBER_OF_PARAMETERS << ")");
+      }
+
+      if (E.ndim() != 1 || costh.ndim() != 1 || channel.ndim() != 1 || E.size() != costh.size() || E.size() != channel.size()) {
+	THROW(JValueOutOfRange, "JppyOscProbTable::evaluateGrid(): Input arrays are not one-dimensional or have different sizes.");
+      }
+
+      const size_t m = parameters.shape(0);
+      const size_t n = E.size();
+
+      const double* const values = parameters.data();
+      const double* const y      = costh.data();
+      const int*    const index  = channel.data();
+
+      vector<double> x(n);
+
+      for (size_t i = 0; i != n; ++i) {
+
+	if (index[i] < 0 || index[i] >= (int) NUMBER_OF_OSCCHANNELS) {
+	  THROW(JValueOutOfRange, "JppyOscProbTable::evaluateGrid(): Invalid oscillation channel index " << index[i]);
+	}
+
+	x[i] = getBaseline(y[i]) / E.data()[i];
+      }
+
+      py::array_t<double> result({ m, n });
+
+      double* const out = result.mutable_data();
+
+      {
+	py::gil_scoped_release release;
+
+	UTILS::getThreadPool().execute(m, n_threads, [&](const size_t begin, const size_t end) {
+
+	    JTOOLS::JArray<NUMBER_OF_DIMENSIONS, argument_type> point(buffer);
+
+	    for (size_t k = begin; k != end; ++k) {
+
+	      for (int j = 0; j != NUMBER_OF_PARAMETERS; ++j) {
+		point[j] = (header->defined[j] ? header->parameters[j] : values[k * NUMBER_OF_PARAMETERS + j]);
+	      }
+
+	      for (size_t i = 0; i != n; ++i) {
+
+		point[NUMBER_OF_DIMENSIONS-2] = x[i];
+		point[NUMBER_OF_DIMENSIONS-1] = y[i];
+
+		out[k * n + i] = evaluate(0, 0, point.data())[index[i]];
+	      }
+	    }
+	  });
+      }
+
+      return result;
+    }
+
+
+    /**
+     * Set oscillation parameters for interpolation.
+     *
+     * The values should be ordered as for method set(const double*).
+     *
+     * \param  values             oscillation parameter values
+     */
+    void setFast(const UTILS::array_type<double>& values)
+    {
+      if (values.size() != NUMBER_OF_PARAMETERS) {
+	THROW(JValueOutOfRange, "JppyOscProbTable::setFast(): Invalid number of oscillation parameter values " << values.size());
+      }
+
+      set(values.data());
+    }
+
+
+    /**
+     * Get oscillation probability for a given oscillation channel.
+     *
+     * \param  channel            oscillation channel
+     * \param  E                  neutrino energy [GeV]
+     * \param  costh              cosine zenith angle
+     * \return                    oscillation probability
+     */
+    double operator()(const JOscChannel& channel,
+		      const double       E,
+		      const double       costh) const
+    {
+      using namespace std;
+      using namespace JPP;
+
+      const int index = getOscChannelIndex(channel);
+
+      if (index == -1) {
+	THROW(JValueOutOfRange, "JppyOscProbTable::operator(): Invalid oscillation channel " << channel);
+      }
+
+      return getProbabilities(E, costh)[index];
+    }
+
+
+    /**
+     * Get oscillation probability for a given set of oscillation parameters\n
+     * and a given oscillation channel.
+     *
+     * \param  parameters         oscillation parameters
+     * \param  channel            oscillation channel
+     * \param  E                  neutrino energy [GeV]
+     * \param  costh              cosine zenith angle
+     * \return                    oscillation probability
+     */
+    double operator()(const JOscParameters& parameters,
+		      const JOscChannel&    channel,
+		      const double          E,
+		      const double          costh)
+    {
+      set(parameters);
+
+      return (*this)(channel, E, costh);
+    }
+
+  protected:
+    /**
+     * Constructor.
+     *
+     * \param  memory             memory-mapped oscillation probability table
+     * \param  name               name of memory-mapped oscillation probability table
+     */
+    JppyOscProbTable(UTILS::JppyMemoryMap* memory, const char* name) :
+      memory(memory)
+    {
+      configure(name);
+    }
+
+  private:
+    /**
+     * Set pointers to the data of the memory-mapped oscillation probability table.
+     *
+     * \param  name               name of memory-mapped oscillation probability table
+     */
+    void configure(const char* name)
+    {
+      using namespace JPP;
+
+      const char* const data = memory->data();
+
+      header = reinterpret_cast<const JppyOscProbTableHeader*>(data);
+
+      if (memory->size() < sizeof(JppyOscProbTableHeader)                                        ||
+	  strncmp(header->magic, JppyOscProbTableHeader::getMagic(), sizeof(header->magic)) != 0 ||
+	  header->version          != JppyOscProbTableHeader::VERSION                            ||
+	  header->numberOfChannels != NUMBER_OF_OSCCHANNELS                                      ||
+	  header->fileSize         >  memory->size()) {
+	THROW(JFileReadException, "JppyOscProbTable::configure(): Invalid oscillation probability table " << name);
+      }
+
+      for (int i = 0; i != NUMBER_OF_DIMENSIONS; ++i) {
+
+	const uint64_t n = (i == 0 ? 1 : header->size[i-1]);
+
+	if (header->degree[i] < 0 || header->degree[i] > MAXIMAL_DEGREE ||
+	    header->size[i] > header->fileSize / sizeof(double)      ||
+	    !check(header->index   [i], (n + 1)         * sizeof(uint64_t)) ||
+	    !check(header->abscissa[i], header->size[i] * sizeof(double))) {
+	  THROW(JFileReadException, "JppyOscProbTable::configure(): Invalid oscillation probability table " << name);
+	}
+
+	index   [i] = reinterpret_cast<const uint64_t*>(data + header->index   [i]);
+	abscissa[i] = reinterpret_cast<const double*>  (data + header->abscissa[i]);
+
+	// offsets of the maps should increase from zero to the number of abscissa values
+
+	if (index[i][0] != 0 || index[i][n] != header->size[i]) {
+	  THROW(JFileReadException, "JppyOscProbTable::configure(): Invalid oscillation probability table " << name);
+	}
+
+	for (uint64_t k = 0; k != n; ++k) {
+	  if (index[i][k] > index[i][k + 1]) {
+	    THROW(JFileReadException, "JppyOscProbTable::configure(): Invalid oscillation probability table " << name);
+	  }
+	}
+      }
+
+      if (!check(header->ordinate, header->size[NUMBER_OF_DIMENSIONS-1] * NUMBER_OF_OSCCHANNELS * sizeof(double))) {
+	THROW(JFileReadException, "JppyOscProbTable::configure(): Invalid oscillation probability table " << name);
+      }
+
+      ordinate = reinterpret_cast<const double*>(data + header->ordinate);
+
+      JOscParameters::JParameter_t* const fixed[] = { &parameters.dM21sq,
+						       &parameters.dM31sq,
+						       &parameters.deltaCP,
+						       &parameters.sinsqTh12,
+						       &parameters.sinsqTh13,
+						       &parameters.sinsqTh23 };
+
+      for (int i = 0; i != NUMBER_OF_PARAMETERS; ++i) {
+	if (header->defined[i]) {
+	  *fixed[i] = header->parameters[i];
+	}
+      }
+
+      getBaseline = JBaselineCalculator(header->Lmin, header->Lmax);
+
+      set(JOscParameters(false)); // Initialize buffer with NuFIT NO best fit parameters
+    }
+
+
+    /**
+     * Check range of array.
+     *
+     * \param  offset             offset [B]
+     * \param  size               size   [B]
+     * \return                    true if array is inside file and aligned; else false
+     */
+    bool check(const uint64_t offset, const uint64_t size) const
+    {
+      return (offset % sizeof(double) == 0 && offset <= header->fileSize && size <= header->fileSize - offset);
+    }
+
+
+    /**
+     * Append map.
+     *
+     * \param  input              map
+     * \param  index              index arrays
+     * \param  abscissa           abscissa values
+     * \param  ordinate           oscillation probabilities
+     * \param  level              level
+     */
+    template<class JMap_t, int N>
+    static void put(const JMap_t&          input,
+		    std::vector<uint64_t>* index,
+		    std::vector<double>*   abscissa,
+		    std::vector<double>&   ordinate,
+		    std::integral_constant<int, N> level)
+    {
+      for (auto i = input.begin(); i != input.end(); ++i) {
+	abscissa[N].push_back(i->getX());
+      }
+
+      index[N].push_back(abscissa[N].size());
+
+      for (auto i = input.begin(); i != input.end(); ++i) {
+	put(i->getY(), index, abscissa, ordinate, std::integral_constant<int, N + 1>());
+      }
+    }
+
+
+    /**
+     * Append oscillation probabilities.
+     *
+     * \param  input              oscillation probabilities
+     * \param  index              index arrays
+     * \param  abscissa           abscissa values
+     * \param  ordinate           oscillation probabilities
+     * \param  level              level
+     */
+    static void put(const result_type&     input,
+		    std::vector<uint64_t>* index,
+		    std::vector<double>*   abscissa,
+		    std::vector<double>&   ordinate,
+		    std::integral_constant<int, NUMBER_OF_DIMENSIONS> level)
+    {
+      ordinate.insert(ordinate.end(), input.begin(), input.end());
+    }
+
+
+    /**
+     * Get aligned offset.
+     *
+     * \param  pos                offset [B]
+     * \return                    aligned offset [B]
+     */
+    static uint64_t getAligned(const uint64_t pos)
+    {
+      return (pos + JppyOscProbTableHeader::ALIGNMENT - 1) / JppyOscProbTableHeader::ALIGNMENT * JppyOscProbTableHeader::ALIGNMENT;
+    }
+
+
+    /**
+     * Copy data to given offset.
+     *
+     * \param  data               pointer to data
+     * \param  size               size   [B]
+     * \param  buffer             output data
+     * \param  pos                offset [B]
+     */
+    static void copy(const void* data, const size_t size, std::vector<char>& buffer, const uint64_t pos)
+    {
+      memcpy(buffer.data() + pos, data, size);
+    }
+
+
+    /**
+     * Get function value of map or oscillation probabilities at given level.
+     *
+     * \param  level              level
+     * \param  i                  index of map or abscissa value of last dimension
+     * \param  pX                 pointer to abscissa values
+     * \return                    function value
+     */
+    result_type getValue(const int level, const size_t i, const argument_type* pX) const
+    {
+      if (level == NUMBER_OF_DIMENSIONS)
+	return result_type(ordinate + i * NUMBER_OF_OSCCHANNELS);
+      else
+	return evaluate(level, i, pX);
+    }
+
+
+    /**
+     * Recursive interpolation method implementation.
+     *
+     * The interpolation is identical to that of JTOOLS::JPolintFunction (see JPHYSICS::getFlatValue).
+     *
+     * \param  level              level
+     * \param  node               index of map
+     * \param  pX                 pointer to abscissa values
+     * \return                    function value
+     */
+    result_type evaluate(const int level, const size_t node, const argument_type* pX) const
+    {
+      const double* const data = abscissa[level];
+
+      return JPHYSICS::getFlatValue<result_type>(header->degree[level],
+						 header->grid  [level],
+						 data,
+						 data + index[level][node],
+						 data + index[level][node + 1],
+						 pX,
+						 [this, level](const size_t i, const argument_type* pX) { return getValue(level + 1, i, pX); },
+						 [](const auto& error) -> result_type { throw error; },
+						 getDistance);
+    }
+
+
+    JLANG::JSharedPointer<UTILS::JppyMemoryMap> memory;       //!< memory-mapped oscillation probability table
+
+    const JppyOscProbTableHeader* header;
+    const uint64_t*               index   [NUMBER_OF_DIMENSIONS];
+    const double*                 abscissa[NUMBER_OF_DIMENSIONS];
+    const double*                 ordinate;
+
+    JOscParameters      parameters;  //!< Fixed oscillation parameters corresponding to the oscillation probability table
+    JBaselineCalculator getBaseline; //!< Baseline functor
+    distance_type       getDistance;
+
+    JTOOLS::JArray<NUMBER_OF_DIMENSIONS, argument_type> buffer; //!< Oscillation parameter values for interpolation
+  };
+}
+
+#endif
@@ -0,0 +1,806 @@
+#ifndef __JPHYSICS__JPPYPDF__
+#define __JPHYSICS__JPPYPDF__
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <memory>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+#include "JPhysics/JPDF_t.hh"
+#include "JPhysics/JGeane.hh"
+#include "JPhysics/JConstants.hh"
+
+#include "utils.hh"
+#include "JppyThreadPool.hh"
+#include "JppyDensePDFTable.hh"
+#include "JppyCompactTable.hh"
+#include "JppyPDFCache.hh"
+
+
+/**
+ * \file
+ *
+ * Auxiliary data structures for vectorised evaluation of PDFs.
+ */
+
+namespace JPHYSICS {}
+namespace JPP { using namespace JPHYSICS; }
+
+namespace JPHYSICS {
+
+  namespace py = pybind11;
+
+  using UTILS::array_type;
+  using UTILS::JBroadcastArray;
+  using UTILS::vectorize;
+
+
+  static const double BLUR_QUANTILE = 0.99;    //!< quantile for blurring of PDF tables (default of JPDFTable::blur)
+
+
+  /**
+   * Blur PDF tables.
+   *
+   * The one-dimensional PDFs of all tables are blurred concurrently using the thread pool of this module.\n
+   * The result is identical to that of JPDFTable::blur, which is used if the number of threads is one.
+   *
+   * \param  tables             PDF tables
+   * \param  TTS                TTS [ns]
+   * \param  numberOfPoints     number of points for Gauss-Hermite integration of TTS
+   * \param  epsilon            precision        for Gauss-Hermite integration of TTS
+   * \param  quantile           quantile
+   * \param  n_threads          number of threads (0 = number of hardware threads; 1 = serial blurring with JPDFTable::blur)
+   */
+  template<class JPDF_t>
+  inline void blur(const std::vector<JPDF_t*>& tables,
+		   const double                TTS,
+		   const int                   numberOfPoints,
+		   const double                epsilon,
+		   const double                quantile  = BLUR_QUANTILE,
+		   const size_t                n_threads = 0)
+  {
+    using namespace std;
+    using namespace JPP;
+
+    typedef typename JPDF_t::array_type                  array_type;
+    typedef typename JPDF_t::function_type               function_type;
+    typedef typename JPDF_t::super_iterator              super_iterator;
+
+    struct cell_type {
+      const JPDF_t*  table;
+      array_type     array;
+      function_type* f1;
+    };
+
+    if (TTS < 0.0) {
+      THROW(JValueOutOfRange, "Illegal value of TTS [ns]: " << TTS);
+    }
+
+    if (TTS == 0.0) {
+      return;
+    }
+
+    if (n_threads == 1) {
+
+      for (JPDF_t* table : tables) {
+	table->blur(TTS, numberOfPoints, epsilon, quantile);
+      }
+
+      return;
+    }
+
+    vector<cell_type> cells;
+
+    for (JPDF_t* table : tables) {
+      for (super_iterator i = table->super_begin(); i != table->super_end(); ++i) {
+	cells.push_back({ table, (*i).getKey(), &(*i).getValue() });
+      }
+    }
+
+    const JGaussHermite engine(numberOfPoints, epsilon);
+
+    UTILS::getThreadPool().execute(cells.size(), n_threads, [&](const size_t begin, const size_t end) {
+	for (size_t i = begin; i != end; ++i) {
+	  cells[i].table->blur(cells[i].array, *cells[i].f1, engine, TTS, quantile);
+	}
+      }, 1);
+  }
+
+
+  /**
+   * Auxiliary data structure for single PDF with vectorised evaluation.
+   */
+  struct JppySinglePDF :
+    public JPDF
+  {
+    typedef JPDF::result_type                                        result_type;
+
+
+    /**
+     * Constructor.
+     *
+     * \param  fileDescriptor     PDF file descriptor
+     * \param  TTS                TTS [ns]
+     * \param  numberOfPoints     number of points for Gauss-Hermite integration of TTS
+     * \param  epsilon            precision        for Gauss-Hermite integration of TTS
+     * \param  n_threads          number of threads for blurring (0 = number of hardware threads)
+     */
+    JppySinglePDF(const std::string& fileDescriptor,
+		  const double       TTS,
+		  const int          numberOfPoints = 25,
+		  const double       epsilon        = 1.0e-10,
+		  const size_t       n_threads      = 0) :
+      JPDF(fileDescriptor, 0.0)
+    {
+      blur(std::vector<JPDF_t*>{ &pdf }, TTS, numberOfPoints, epsilon, BLUR_QUANTILE, n_threads);
+    }
+
+
+    using JPDF::calculate;
+
+
+    /**
+     * Get PDF.
+     *
+     * Input arrays with a single element are broadcast to the size of the other input arrays.\n
+     * The evaluation is made without holding the Python global interpreter lock.
+     *
+     * \param  E                  muon energies at minimum distance of approach [GeV]
+     * \param  R                  minimum distances of approach [m]
+     * \param  theta              PMT zenith  angles [rad]
+     * \param  phi                PMT azimuth angles [rad]
+     * \param  t1                 arrival times relative to Cherenkov hypothesis [ns]
+     * \param  out                output array or None
+     * \return                    hypothesis values
+     */
+    py::array_t<result_type> calculate(const array_type<double>& E,
+				       const array_type<double>& R,
+				       const array_type<double>& theta,
+				       const array_type<double>& phi,
+				       const array_type<double>& t1,
+				       const py::object&         out) const
+    {
+      return vectorize<result_type>([this](const double E, const double R, const double theta, const double phi, const double t1) {
+	  return this->JPDF::calculate(E, R, theta, phi, t1);
+	},
+	out,
+	JBroadcastArray<double>(E),
+	JBroadcastArray<double>(R),
+	JBroadcastArray<double>(theta),
+	JBroadcastArray<double>(phi),
+	JBroadcastArray<double>(t1));
+    }
+
+
+    /**
+     * Get PDF using multiple threads.
+     *
+     * Input arrays with a single element are broadcast to the size of the other input arrays.\n
+     * The input arrays are split in chunks which are evaluated in parallel by a persistent pool of threads
+     * without holding the Python global interpreter lock.
+     *
+     * \param  E                  muon energies at minimum distance of approach [GeV]
+     * \param  R                  minimum distances of approach [m]
+     * \param  theta              PMT zenith  angles [rad]
+     * \param  phi                PMT azimuth angles [rad]
+     * \param  t1                 arrival times relative to Cherenkov hypothesis [ns]
+     * \param  n_threads          number of threads (0 = number of hardware threads)
+     * \param  out                output array or None
+     * \return                    hypothesis values
+     */
+    py::array_t<result_type> calculateMany(const array_type<double>& E,
+				           const array_type<double>& R,
+				           const array_type<double>& theta,
+				           const array_type<double>& phi,
+				           const array_type<double>& t1,
+				           const size_t              n_threads,
+				           const py::object&         out) const
+    {
+      return vectorize<result_type>([this](const double E, const double R, const double theta, const double phi, const double t1) {
+	  return this->JPDF::calculate(E, R, theta, phi, t1);
+	},
+	out,
+	n_threads,
+	JBroadcastArray<double>(E),
+	JBroadcastArray<double>(R),
+	JBroadcastArray<double>(theta),
+	JBroadcastArray<double>(phi),
+	JBroadcastArray<double>(t1));
+    }
+  };
+
+
+  /**
+   * Auxiliary data structure for muon PDF with vectorised evaluation.
+   */
+  struct JppyMuonPDF :
+    public JMuonPDF_t
+  {
+    typedef JMuonPDF_t::result_type                                  result_type;
+    typedef JppyDensePDFTable<JFunction1D_t, JPDFMaplist_t>          JDensePDF_t;
+    typedef JppyCompactPDFTable<JFunction1D_t, JPDFMaplist_t>        JCompactPDF_t;
+
+
+    /**
+     * Constructor.
+     *
+     * If a cache directory is specified (see JPHYSICS::JppyPDFCache), the blurred PDFs are loaded from the cache if available
+     * and otherwise stored in the cache after they have been computed.
+     * The PDF files are loaded concurrently and each pair of PDFs is added as soon as both have been loaded.
+     *
+     * \param  fileDescriptor     PDF file descriptor
+     * \param  TTS                TTS [ns]
+     * \param  numberOfPoints     number of points for Gauss-Hermite integration of TTS
+     * \param  epsilon            precision        for Gauss-Hermite integration of TTS
+     * \param  cacheDirectory     cache directory
+     * \param  n_threads          number of threads for blurring (0 = number of hardware threads)
+     */
+    JppyMuonPDF(const std::string& fileDescriptor,
+		const double       TTS,
+		const int          numberOfPoints = 25,
+		const double       epsilon        = 1.0e-10,
+		const std::string& cacheDirectory = "",
+		const size_t       n_threads      = 0)
+    {
+      using namespace std;
+      using namespace JPP;
+
+      const JppyPDFCache cache(cacheDirectory);
+
+      string key;
+
+      if (TTS > 0.0 && cache.is_enabled()) {
+
+	key = cache.getKey("muon", getFilenames(fileDescriptor), TTS, numberOfPoints, epsilon, BLUR_QUANTILE);
+
+	if (cache.load(key, vector<JPDF_t*>{ &pdfA, &pdfB, &pdfC })) {
+
+	  const JPDF_t::JSupervisor supervisor(new JPDF_t::JDefaultResult(zero));
+
+	  pdfA.setExceptionHandler(supervisor);
+	  pdfB.setExceptionHandler(supervisor);
+	  pdfC.setExceptionHandler(supervisor);
+
+	  return;
+	}
+      }
+
+      load(fileDescriptor, UTILS::JConcurrentLoader());
+
+      blur(vector<JPDF_t*>{ &pdfA, &pdfB, &pdfC }, TTS, numberOfPoints, epsilon, BLUR_QUANTILE, n_threads);
+
+      if (!key.empty()) {
+	cache.store(key, vector<const JPDF_t*>{ &pdfA, &pdfB, &pdfC });
+      }
+    }
+
+
+    /**
+     * Resample PDFs on uniform grids.
+     *
+     * After a successful call, all subsequent evaluations make use of the resampled PDFs.
+     * The resampled PDFs are published atomically, so that concurrent evaluations use either the previous or the resampled PDFs.
+     * The number of nodes per dimension refers to R, theta, phi and the transformed arrival time, respectively.
+     *
+     * \param  numberOfPoints     number of nodes per dimension (empty or 0 = number of nodes in original PDF)
+     * \param  precision          maximal relative deviation with respect to original PDFs (0 = no check)
+     * \return                    maximal relative deviation with respect to original PDFs
+     */
+    double resample(const std::vector<size_t>& numberOfPoints,
+		    const double               precision)
+    {
+      using namespace std;
+
+      JDensePDF_t A(pdfA, numberOfPoints);
+      JDensePDF_t B(pdfB, numberOfPoints);
+      JDensePDF_t C(pdfC, numberOfPoints);
+
+      const double deviation = max(max(A.getMaximalDeviation(pdfA),
+				       B.getMaximalDeviation(pdfB)),
+				   C.getMaximalDeviation(pdfC));
+
+      if (precision > 0.0 && deviation > precision) {
+	THROW(JValueOutOfRange, "JppyMuonPDF::resample(): Deviation of resampled PDF " << deviation << " > " << precision);
+      }
+
+      std::atomic_store(&dense,     std::make_shared<const JTables<JDensePDF_t> >(std::move(A), std::move(B), std::move(C)));
+      std::atomic_store(&compacted, std::shared_ptr<const JTables<JCompactPDF_t> >());
+
+      return deviation;
+    }
+
+
+    /**
+     * Compact PDFs.
+     *
+     * The PDFs are converted to compacted read-only tables, in which all nodes are stored in contiguous arrays.\n
+     * After this call, all subsequent evaluations make use of the compacted PDFs.
+     * The compacted PDFs are published atomically, so that concurrent evaluations use either the previous or the compacted PDFs.
+     * The results are identical to those of the original PDFs.
+     *
+     * Note that the original PDFs are kept (e.g.\ for a subsequent call to resample),
+     * so that the memory consumption is about twice that of the original PDFs.
+     */
+    void compact()
+    {
+      std::atomic_store(&compacted, std::make_shared<const JTables<JCompactPDF_t> >(JCompactPDF_t(pdfA), JCompactPDF_t(pdfB), JCompactPDF_t(pdfC)));
+      std::atomic_store(&dense,     std::shared_ptr<const JTables<JDensePDF_t> >());
+    }
+
+
+    /**
+     * Get PDF.
+     *
+     * If the PDFs have been resampled or compacted, the resampled or compacted PDFs are used, respectively.
+     *
+     * \param  E                  muon energy at minimum distance of approach [GeV]
+     * \param  R                  minimum distance of approach [m]
+     * \param  theta              PMT zenith  angle [rad]
+     * \param  phi                PMT azimuth angle [rad]
+     * \param  t1                 arrival time relative to Cherenkov hypothesis [ns]
+     * \return                    hypothesis value
+     */
+    result_type calculate(const double E,
+			  const double R,
+			  const double theta,
+			  const double phi,
+			  const double t1) const
+    {
+      return calculate(getSnapshot(), E, R, theta, phi, t1);
+    }
+
+
+    /**
+     * Get PDF.
+     *
+     * Input arrays with a single element are broadcast to the size of the other input arrays.\n
+     * The evaluation is made without holding the Python global interpreter lock.
+     *
+     * \param  E                  muon energies at minimum distance of approach [GeV]
+     * \param  R                  minimum distances of approach [m]
+     * \param  theta              PMT zenith  angles [rad]
+     * \param  phi                PMT azimuth angles [rad]
+     * \param  t1                 arrival times relative to Cherenkov hypothesis [ns]
+     * \param  out                output array or None
+     * \return                    hypothesis values
+     */
+    py::array_t<result_type> calculate(const array_type<double>& E,
+				       const array_type<double>& R,
+				       const array_type<double>& theta,
+				       const array_type<double>& phi,
+				       const array_type<double>& t1,
+				       const py::object&         out) const
+    {
+      const JSnapshot snapshot = getSnapshot();
+
+      return vectorize<result_type>([this, &snapshot](const double E, const double R, const double theta, const double phi, const double t1) {
+	  return this->calculate(snapshot, E, R, theta, phi, t1);
+	},
+	out,
+	JBroadcastArray<double>(E),
+	JBroadcastArray<double>(R),
+	JBroadcastArray<double>(theta),
+	JBroadcastArray<double>(phi),
+	JBroadcastArray<double>(t1));
+    }
+
+
+    /**
+     * Get PDF using multiple threads.
+     *
+     * Input arrays with a single element are broadcast to the size of the other input arrays.\n
+     * The input arrays are split in chunks which are evaluated in parallel by a persistent pool of threads
+     * without holding the Python global interpreter lock.
+     *
+     * \param  E                  muon energies at minimum distance of approach [GeV]
+     * \param  R                  minimum distances of approach [m]
+     * \param  theta              PMT zenith  angles [rad]
+     * \param  phi                PMT azimuth angles [rad]
+     * \param  t1                 arrival times relative to Cherenkov hypothesis [ns]
+     * \param  n_threads          number of threads (0 = number of hardware threads)
+     * \param  out                output array or None
+     * \return                    hypothesis values
+     */
+    py::array_t<result_type> calculateMany(const array_type<double>& E,
+				           const array_type<double>& R,
+				           const array_type<double>& theta,
+				           const array_type<double>& phi,
+				           const array_type<double>& t1,
+				           const size_t              n_threads,
+				           const py::object&         out) const
+    {
+      const JSnapshot snapshot = getSnapshot();
+
+      return vectorize<result_type>([this, &snapshot](const double E, const double R, const double theta, const double phi, const double t1) {
+	  return this->calculate(snapshot, E, R, theta, phi, t1);
+	},
+	out,
+	n_threads,
+	JBroadcastArray<double>(E),
+	JBroadcastArray<double>(R),
+	JBroadcastArray<double>(theta),
+	JBroadcastArray<double>(phi),
+	JBroadcastArray<double>(t1));
+    }
+
+    /**
+     * Get PDF for a muon with given energy and time at the simulated vertex.
+     *
+     * The minimal distance of approach, the muon energy at the point of minimal distance of approach
+     * and the expected arrival time of the Cherenkov light are derived from the hit position.
+     *
+     * \param  E                  muon energy at simulated vertex [GeV]
+     * \param  t0                 time at simulated vertex [ns]
+     * \param  D                  hit distance with respect to simulated vertex [m]
+     * \param  cd                 cosine of angle between muon direction and PMT position
+     * \param  theta              PMT zenith  angle [rad]
+     * \param  phi                PMT azimuth angle [rad]
+     * \param  t_obs              observed hit time [ns]
+     * \return                    hypothesis value
+     */
+    result_type evaluate(const double E,
+			 const double t0,
+			 const double D,
+			 const double cd,
+			 const double theta,
+			 const double phi,
+			 const double t_obs) const
+    {
+      return evaluate(getSnapshot(), E, t0, D, cd, theta, phi, t_obs);
+    }
+
+
+    /**
+     * Get PDF for a muon with given energy and time at the simulated vertex.
+     *
+     * Input arrays with a single element are broadcast to the size of the other input arrays.\n
+     * The evaluation is made in a single pass without holding the Python global interpreter lock.
+     *
+     * \param  E                  muon energy at simulated vertex [GeV]
+     * \param  t0                 time at simulated vertex [ns]
+     * \param  D                  hit distances with respect to simulated vertex [m]
+     * \param  cd                 cosines of angle between muon direction and PMT position
+     * \param  theta              PMT zenith  angles [rad]
+     * \param  phi                PMT azimuth angles [rad]
+     * \param  t_obs              observed hit times [ns]
+     * \param  out                output array or None
+     * \return                    hypothesis values
+     */
+    py::array_t<result_type> evaluate(const double              E,
+				      const double              t0,
+				      const array_type<double>& D,
+				      const array_type<double>& cd,
+				      const array_type<double>& theta,
+				      const array_type<double>& phi,
+				      const array_type<double>& t_obs,
+				      const py::object&         out) const
+    {
+      const JSnapshot snapshot = getSnapshot();
+
+      return vectorize<result_type>([this, &snapshot, E, t0](const double D, const double cd, const double theta, const double phi, const double t_obs) {
+	  return this->evaluate(snapshot, E, t0, D, cd, theta, phi, t_obs);
+	},
+	out,
+	JBroadcastArray<double>(D),
+	JBroadcastArray<double>(cd),
+	JBroadcastArray<double>(theta),
+	JBroadcastArray<double>(phi),
+	JBroadcastArray<double>(t_obs));
+    }
+
+  private:
+    /**
+     * PDF tables for minimum ionising particle, average energy losses and delta-rays.
+     */
+    template<class JTable_t>
+    struct JTables {
+      /**
+       * Constructor.
+       *
+       * \param  A              PDF for minimum ionising particle
+       * \param  B              PDF for average energy losses
+       * \param  C              PDF for delta-rays
+       */
+      JTables(JTable_t&& A, JTable_t&& B, JTable_t&& C) :
+	A(std::move(A)),
+	B(std::move(B)),
+	C(std::move(C))
+      {}
+
+      JTable_t A;
+      JTable_t B;
+      JTable_t C;
+    };
+
+
+    /**
+     * Resampled and compacted PDF tables in use at the start of an evaluation.
+     */
+    struct JSnapshot {
+      std::shared_ptr<const JTables<JDensePDF_t> >   dense;
+      std::shared_ptr<const JTables<JCompactPDF_t> > compacted;
+    };
+
+
+    /**
+     * Get resampled and compacted PDF tables.
+     *
+     * \return                    snapshot
+     */
+    JSnapshot getSnapshot() const
+    {
+      return JSnapshot{ std::atomic_load(&dense), std::atomic_load(&compacted) };
+    }
+
+
+    /**
+     * Get PDF.
+     *
+     * If the PDFs have been resampled or compacted, the resampled or compacted PDFs are used, respectively.
+     *
+     * \param  snapshot           resampled and compacted PDF tables
+     * \param  E                  muon energy at minimum distance of approach [GeV]
+     * \param  R                  minimum distance of approach [m]
+     * \param  theta              PMT zenith  angle [rad]
+     * \param  phi                PMT azimuth angle [rad]
+     * \param  t1                 arrival time relative to Cherenkov hypothesis [ns]
+     * \return                    hypothesis value
+     */
+    result_type calculate(const JSnapshot& snapshot,
+			  const double     E,
+			  const double     R,
+			  const double     theta,
+			  const double     phi,
+			  const double     t1) const
+    {
+      if (snapshot.dense)
+	return getPDF(snapshot.dense->A,     snapshot.dense->B,     snapshot.dense->C,     E, R, theta, phi, t1);
+      else if (snapshot.compacted)
+	return getPDF(snapshot.compacted->A, snapshot.compacted->B, snapshot.compacted->C, E, R, theta, phi, t1);
+      else
+	return JMuonPDF_t::calculate(E, R, theta, phi, t1);
+    }
+
+
+    /**
+     * Get PDF for a muon with given energy and time at the simulated vertex.
+     *
+     * \param  snapshot           resampled and compacted PDF tables
+     * \param  E                  muon energy at simulated vertex [GeV]
+     * \param  t0                 time at simulated vertex [ns]
+     * \param  D                  hit distance with respect to simulated vertex [m]
+     * \param  cd                 cosine of angle between muon direction and PMT position
+     * \param  theta              PMT zenith  angle [rad]
+     * \param  phi                PMT azimuth angle [rad]
+     * \param  t_obs              observed hit time [ns]
+     * \return                    hypothesis value
+     */
+    result_type evaluate(const JSnapshot& snapshot,
+			 const double     E,
+			 const double     t0,
+			 const double     D,
+			 const double     cd,
+			 const double     theta,
+			 const double     phi,
+			 const double     t_obs) const
+    {
+      const double dz = D * cd;
+      const double R  = sqrt((D + dz) * (D - dz));
+
+      const double t1 = t0 + (dz + R * getKappaC()) * getInverseSpeedOfLight();
+
+      return calculate(snapshot, gWater.getE(E, dz), R, theta, phi, t_obs - t1);
+    }
+
+
+    std::shared_ptr<const JTables<JDensePDF_t> >   dense;        //!< resampled PDFs
+    std::shared_ptr<const JTables<JCompactPDF_t> > compacted;    //!< compacted PDFs
+  };
+
+
+  /**
+   * Auxiliary data structure for shower PDF with vectorised evaluation.
+   */
+  struct JppyShowerPDF :
+    public JShowerPDF_t
+  {
+    typedef JShowerPDF_t::result_type                                result_type;
+
+
+    /**
+     * Constructor.
+     *
+     * If a cache directory is specified (see JPHYSICS::JppyPDFCache), the blurred PDF is loaded from the cache if available
+     * and otherwise stored in the cache after it has been computed.
+     *
+     * \param  fileDescriptor     PDF file descriptor
+     * \param  TTS                TTS [ns]
+     * \param  numberOfPoints     number of points for Gauss-Hermite integration of TTS
+     * \param  epsilon            precision        for Gauss-Hermite integration of TTS
+     * \param  cacheDirectory     cache directory
+     * \param  n_threads          number of threads for blurring (0 = number of hardware threads)
+     */
+    JppyShowerPDF(const std::string& fileDescriptor,
+		  const double       TTS,
+		  const int          numberOfPoints = 25,
+		  const double       epsilon        = 1.0e-10,
+		  const std::string& cacheDirectory = "",
+		  const size_t       n_threads      = 0)
+    {
+      using namespace std;
+      using namespace JPP;
+
+      const JppyPDFCache cache(cacheDirectory);
+
+      string key;
+
+      if (TTS > 0.0 && cache.is_enabled()) {
+
+	key = cache.getKey("shower", getFilenames(fileDescriptor), TTS, numberOfPoints, epsilon, BLUR_QUANTILE);
+
+	if (cache.load(key, vector<JPDF_t*>{ &pdfA })) {
+
+	  const JPDF_t::JSupervisor supervisor(new JPDF_t::JDefaultResult(zero));
+
+	  pdfA.setExceptionHandler(supervisor);
+
+	  return;
+	}
+      }
+
+      load(fileDescriptor, UTILS::JConcurrentLoader());
+
+      blur(vector<JPDF_t*>{ &pdfA }, TTS, numberOfPoints, epsilon, BLUR_QUANTILE, n_threads);
+
+      if (!key.empty()) {
+	cache.store(key, vector<const JPDF_t*>{ &pdfA });
+      }
+    }
+
+
+    using JShowerPDF_t::calculate;
+
+
+    /**
+     * Get PDF.
+     *
+     * Input arrays with a single element are broadcast to the size of the other input arrays.\n
+     * The evaluation is made without holding the Python global interpreter lock.
+     *
+     * \param  E                  shower energies [GeV]
+     * \param  D                  distances [m]
+     * \param  cd                 cosines of emission angle
+     * \param  theta              PMT zenith  angles [rad]
+     * \param  phi                PMT azimuth angles [rad]
+     * \param  t1                 arrival times relative to Cherenkov hypothesis [ns]
+     * \param  out                output array or None
+     * \return                    hypothesis values
+     */
+    py::array_t<result_type> calculate(const array_type<double>& E,
+				       const array_type<double>& D,
+				       const array_type<double>& cd,
+				       const array_type<double>& theta,
+				       const array_type<double>& phi,
+				       const array_type<double>& t1,
+				       const py::object&         out) const
+    {
+      return vectorize<result_type>([this](const double E, const double D, const double cd, const double theta, const double phi, const double t1) {
+	  return this->JShowerPDF_t::calculate(E, D, cd, theta, phi, t1);
+	},
+	out,
+	JBroadcastArray<double>(E),
+	JBroadcastArray<double>(D),
+	JBroadcastArray<double>(cd),
+	JBroadcastArray<double>(theta),
+	JBroadcastArray<double>(phi),
+	JBroadcastArray<double>(t1));
+    }
+
+
+    /**
+     * Get PDF using multiple threads.
+     *
+     * Input arrays with a single element are broadcast to the size of the other input arrays.\n
+     * The input arrays are split in chunks which are evaluated in parallel by a persistent pool of threads
+     * without holding the Python global interpreter lock.
+     *
+     * \param  E                  shower energies [GeV]
+     * \param  D                  distances [m]
+     * \param  cd                 cosines of emission angle
+     * \param  theta              PMT zenith  angles [rad]
+     * \param  phi                PMT azimuth angles [rad]
+     * \param  t1                 arrival times relative to Cherenkov hypothesis [ns]
+     * \param  n_threads          number of threads (0 = number of hardware threads)
+     * \param  out                output array or None
+     * \return                    hypothesis values
+     */
+    py::array_t<result_type> calculateMany(const array_type<double>& E,
+				           const array_type<double>& D,
+				           const array_type<double>& cd,
+				           const array_type<double>& theta,
+				           const array_type<double>& phi,
+				           const array_type<double>& t1,
+				           const size_t              n_threads,
+				           const py::object&         out) const
+    {
+      return vectorize<result_type>([this](const double E, const double D, const double cd, const double theta, const double phi, const double t1) {
+	  return this->JShowerPDF_t::calculate(E, D, cd, theta, phi, t1);
+	},
+	out,
+	n_threads,
+	JBroadcastArray<double>(E),
+	JBroadcastArray<double>(D),
+	JBroadcastArray<double>(cd),
+	JBroadcastArray<double>(theta),
+	JBroadcastArray<double>(phi),
+	JBroadcastArray<double>(t1));
+    }
+
+    /**
+     * Get PDF for a shower with given energy and time at the vertex.
+     *
+     * \param  E                  shower energy [GeV]
+     * \param  t0                 time at shower vertex [ns]
+     * \param  D                  hit distance with respect to shower vertex [m]
+     * \param  cd                 cosine of angle between shower direction and PMT position
+     * \param  theta              PMT zenith  angle [rad]
+     * \param  phi                PMT azimuth angle [rad]
+     * \param  t_obs              observed hit time [ns]
+     * \return                    hypothesis value
+     */
+    result_type evaluate(const double E,
+			 const double t0,
+			 const double D,
+			 const double cd,
+			 const double theta,
+			 const double phi,
+			 const double t_obs) const
+    {
+      const double t1 = t0 + D * getInverseSpeedOfLight() * getIndexOfRefraction();
+
+      return JShowerPDF_t::calculate(E, D, cd, theta, phi, t_obs - t1);
+    }
+
+
+    /**
+     * Get PDF for a shower with given energy and time at the vertex.
+     *
+     * Input arrays with a single element are broadcast to the size of the other input arrays.\n
+     * The evaluation is made in a single pass without holding the Python global interpreter lock.
+     *
+     * \param  E                  shower energy [GeV]
+     * \param  t0                 time at shower vertex [ns]
+     * \param  D                  hit distances with respect to shower vertex [m]
+     * \param  cd                 cosines of angle between shower direction and PMT position
+     * \param  theta              PMT zenith  angles [rad]
+     * \param  phi                PMT azimuth angles [rad]
+     * \param  t_obs              observed hit times [ns]
+     * \param  out                output array or None
+     * \return                    hypothesis values
+     */
+    py::array_t<result_type> evaluate(const double              E,
+				      const double              t0,
+				      const array_type<double>& D,
+				      const array_type<double>& cd,
+				      const array_type<double>& theta,
+				      const array_type<double>& phi,
+				      const array_type<double>& t_obs,
+				      const py::object&         out) const
+    {
+      return vectorize<result_type>([this, E, t0](const double D, const double cd, const double theta, const double phi, const double t_obs) {
+	  return this->evaluate(E, t0, D, cd, theta, phi, t_obs);
+	},
+	out,
+	JBroadcastArray<double>(D),
+	JBroadcastArray<double>(cd),
+	JBroadcastArray<double>(theta),
+	JBroadcastArray<double>(phi),
+	JBroadcastArray<double>(t_obs));
+    }
+  };
+}
+
+#endif
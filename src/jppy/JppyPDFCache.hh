@@ -0,0 +1,285 @@
+#ifndef __JPHYSICS__JPPYPDFCACHE__
+#define __JPHYSICS__JPPYPDFCACHE__
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+
+#include <sys/stat.h>
+
+#include "JLang/JException.hh"
+
+#include "JppyThreadPool.hh"
+
+
+/**
+ * \file
+ *
+ * On-disk cache of blurred PDF tables.
+ */
+
+namespace JPHYSICS {}
+namespace JPP { using namespace JPHYSICS; }
+
+namespace JPHYSICS {
+
+  using JLANG::JFileOpenException;
+
+
+  /**
+   * Content-addressed cache of PDF tables.
+   *
+   * The key of an entry is a hash of the version of the cache format (see JppyPDFCache::CACHE_VERSION),
+   * of the names, sizes and modification times of the source files and of the parameters used for blurring the PDFs.\n
+   * The contents of the source files are not read, so a modification that preserves both the size and the modification time of a file is not detected.\n
+   * Each table of an entry is stored in a separate file using the JIO::JObjectBinaryIO interface of the table.
+   * The files are first written under a temporary name and then renamed,
+   * so that concurrent processes can safely share the same cache directory.
+   */
+  class JppyPDFCache {
+  public:
+    /**
+     * Version of the cache format.
+     *
+     * To be incremented when the format of the tables or the blurring of the PDFs changes.
+     */
+    static const int CACHE_VERSION = 1;
+
+
+    /**
+     * Constructor.
+     *
+     * If the given directory is empty, the directory is taken from the environment variable <tt>JPPY_CACHE_DIR</tt>.\n
+     * If neither is set, the cache is disabled.
+     * The directory should exist.
+     *
+     * \param  directory          cache directory
+     */
+    JppyPDFCache(const std::string& directory)
+    {
+      if (!directory.empty()) {
+
+	this->directory = directory;
+
+      } else if (const char* const buffer = std::getenv("JPPY_CACHE_DIR")) {
+
+	this->directory = buffer;
+      }
+    }
+
+
+    /**
+     * Check whether cache is enabled.
+     *
+     * \return                    true if enabled; else false
+     */
+    bool is_enabled() const
+    {
+      return !directory.empty();
+    }
+
+
+    /**
+     * Get key of cache entry.
+     *
+     * \param  label              type of entry
+     * \param  file_names         source file names
+     * \param  TTS                TTS [ns]
+     * \param  numberOfPoints     number of points for Gauss-Hermite integration of TTS
+     * \param  epsilon            precision        for Gauss-Hermite integration of TTS
+     * \param  quantile           quantile
+     * \return                    key
+     */
+    static std::string getKey(const std::string&              label,
+			      const std::vector<std::string>& file_names,
+			      const double                    TTS,
+			      const int                       numberOfPoints,
+			      const double                    epsilon,
+			      const double                    quantile)
+    {
+      using namespace std;
+
+      uint64_t hash = FNV_OFFSET_BASIS;
+
+      hash = getHash(hash, label.data(), label.size());
+
+      const int version = CACHE_VERSION;
+
+      hash = getHash(hash, &version, sizeof(version));
+
+      for (const string& file_name : file_names) {
+
+	struct stat status;
+
+	if (stat(file_name.c_str(), &status) != 0) {
+	  THROW(JFileOpenException, "JppyPDFCache::getKey(): Error accessing file " << file_name);
+	}
+
+	const int64_t size  = status.st_size;
+	const int64_t mtime = status.st_mtime;
+
+	hash = getHash(hash, file_name.c_str(), file_name.size() + 1);
+	hash = getHash(hash, &size,  sizeof(size));
+	hash = getHash(hash, &mtime, sizeof(mtime));
+      }
+
+      hash = getHash(hash, &TTS,            sizeof(TTS));
+      hash = getHash(hash, &numberOfPoints, sizeof(numberOfPoints));
+      hash = getHash(hash, &epsilon,        sizeof(epsilon));
+      hash = getHash(hash, &quantile,       sizeof(quantile));
+
+      ostringstream os;
+
+      os << label << '_' << hex << setw(16) << setfill('0') << hash;
+
+      return os.str();
+    }
+
+
+    /**
+     * Load tables of cache entry.
+     *
+     * \param  key                key
+     * \param  tables             tables
+     * \return                    true if all tables have been loaded; else false
+     */
+    template<class JTable_t>
+    bool load(const std::string& key, const std::vector<JTable_t*>& tables) const
+    {
+      using namespace std;
+
+      for (size_t i = 0; i != tables.size(); ++i) {
+	if (!ifstream(getFilename(key, i).c_str())) {
+	  return false;
+	}
+      }
+
+      for (size_t i = 0; i != tables.size(); ++i) {
+
+	const string file_name = getFilename(key, i);
+
+	try {
+	  tables[i]->load(file_name.c_str());
+	}
+	catch(const JLANG::JException& error) {
+
+	  UTILS::printLine("loading input from cache file " + file_name + "... failed");
+
+	  return false;
+	}
+
+	UTILS::printLine("loading input from cache file " + file_name + "... OK");
+      }
+
+      return true;
+    }
+
+
+    /**
+     * Store tables of cache entry.
+     *
+     * Errors are reported but otherwise ignored.
+     *
+     * \param  key                key
+     * \param  tables             tables
+     */
+    template<class JTable_t>
+    void store(const std::string& key, const std::vector<const JTable_t*>& tables) const
+    {
+      using namespace std;
+
+      for (size_t i = 0; i != tables.size(); ++i) {
+
+	const string file_name = getFilename(key, i);
+	const string tmp_name  = getTemporaryFilename(file_name);
+
+	try {
+
+	  tables[i]->store(tmp_name.c_str());
+
+	  if (rename(tmp_name.c_str(), file_name.c_str()) != 0) {
+	    THROW(JFileOpenException, "Error renaming file " << tmp_name << " to " << file_name);
+	  }
+	}
+	catch(const JLANG::JException& error) {
+
+	  remove(tmp_name.c_str());
+
+	  cerr << "JppyPDFCache::store(): " << error.what() << endl;
+
+	  return;
+	}
+      }
+    }
+
+  private:
+    /**
+     * Get file name of table of cache entry.
+     *
+     * \param  key                key
+     * \param  index              index of table
+     * \return                    file name
+     */
+    std::string getFilename(const std::string& key, const size_t index) const
+    {
+      std::ostringstream os;
+
+      os << directory << '/' << "jppy_" << key << '_' << index << ".dat";
+
+      return os.str();
+    }
+
+
+    /**
+     * Get unique temporary file name.
+     *
+     * \param  file_name          file name
+     * \return                    temporary file name
+     */
+    static std::string getTemporaryFilename(const std::string& file_name)
+    {
+      std::random_device device;
+
+      std::ostringstream os;
+
+      os << file_name << '.' << std::hex << device() << device() << ".tmp";
+
+      return os.str();
+    }
+
+
+    /**
+     * Update FNV-1a hash with given data.
+     *
+     * \param  hash               hash
+     * \param  data               pointer to data
+     * \param  size               number of bytes
+     * \return                    hash
+     */
+    static uint64_t getHash(uint64_t hash, const void* data, const size_t size)
+    {
+      const unsigned char* p = static_cast<const unsigned char*>(data);
+
+      for (size_t i = 0; i != size; ++i) {
+	hash ^= p[i];
+	hash *= FNV_PRIME;
+      }
+
+      return hash;
+    }
+
+    static const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+    static const uint64_t FNV_PRIME        = 1099511628211ULL;
+
+    std::string directory;
+  };
+}
+
+#endif
@@ -0,0 +1,382 @@
+#ifndef __JPPY_THREADPOOL__
+#define __JPPY_THREADPOOL__
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <atomic>
+#include <algorithm>
+#include <string>
+#include <iostream>
+#include <new>
+
+#include <pthread.h>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+#include "utils.hh"
+
+
+/**
+ * \file
+ *
+ * Thread pool for multi-threaded evaluation of arrays.
+ */
+
+namespace UTILS {
+
+  namespace py = pybind11;
+
+
+  /**
+   * Persistent pool of worker threads.
+   *
+   * The worker threads are started on demand and kept alive until the pool is destroyed.\n
+   * A child process created with fork inherits the pool but none of its worker threads,
+   * so the pool should then be reset (see method resetAfterFork).
+   */
+  class JThreadPool {
+  public:
+    /**
+     * Default constructor.
+     */
+    JThreadPool() :
+      stop(false)
+    {}
+
+
+    /**
+     * Destructor.
+     */
+    ~JThreadPool()
+    {
+      {
+	std::unique_lock<std::mutex> lock(tasks_mutex);
+
+	stop = true;
+      }
+
+      tasks_cv.notify_all();
+
+      for (std::thread& worker : workers) {
+	worker.join();
+      }
+    }
+
+
+    /**
+     * Get number of threads to be used by default.
+     *
+     * \return                  number of hardware threads
+     */
+    static size_t getDefaultNumberOfThreads()
+    {
+      return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+
+    /**
+     * Execute function for consecutive chunks of the index range <tt>[0, n)</tt>.
+     *
+     * The function should be callable as <tt>function(begin, end)</tt>.\n
+     * This method blocks until all chunks have been processed.
+     * The first exception thrown by the function is rethrown.
+     *
+     * \param  n                number of elements
+     * \param  n_threads        number of threads (0 = number of hardware threads)
+     * \param  function         function
+     * \param  minimal_chunk    minimal number of elements per chunk
+     */
+    void execute(const size_t n,
+		 size_t       n_threads,
+		 const std::function<void(size_t, size_t)>& function,
+		 const size_t minimal_chunk = MINIMAL_CHUNK_SIZE)
+    {
+      using namespace std;
+
+      if (n_threads == 0) {
+	n_threads = getDefaultNumberOfThreads();
+      }
+
+      const size_t chunk = max(max((size_t) 1, minimal_chunk), (n + 4 * n_threads - 1) / (4 * n_threads));
+      const size_t N     = (n + chunk - 1) / chunk;
+
+      n_threads = min(n_threads, N);
+
+      if (n_threads <= 1) {
+
+	function(0, n);
+
+	return;
+      }
+
+      resize(n_threads);
+
+      atomic<size_t>     next(0);
+      size_t             done = 0;
+      exception_ptr      error;
+      std::mutex         m;
+      condition_variable finished;
+
+      auto task = [&]() {
+
+	for (size_t i; (i = next++) < N; ) {
+
+	  try {
+	    function(i * chunk, min(n, (i + 1) * chunk));
+	  }
+	  catch(...) {
+
+	    unique_lock<std::mutex> lock(m);
+
+	    if (!error) {
+	      error = current_exception();
+	    }
+
+	    next = N;
+	  }
+	}
+
+	unique_lock<std::mutex> lock(m);
+
+	++done;
+
+	finished.notify_one();
+      };
+
+      {
+	unique_lock<std::mutex> lock(tasks_mutex);
+
+	for (size_t i = 0; i != n_threads; ++i) {
+	  tasks.push(task);
+	}
+      }
+
+      tasks_cv.notify_all();
+
+      {
+	unique_lock<std::mutex> lock(m);
+
+	finished.wait(lock, [&]() { return done == n_threads; });
+      }
+
+      if (error) {
+	rethrow_exception(error);
+      }
+    }
+
+
+    /**
+     * Reset pool in child process after fork.
+     *
+     * The worker threads, the pending tasks and the state of the lock belong to the parent process.
+     * They are abandoned without being joined or destroyed and new worker threads are started on demand.
+     * This method should only be called when the process is single threaded, i.e.\ from a <tt>pthread_atfork</tt> child handler.
+     */
+    void resetAfterFork()
+    {
+      new (&workers)     std::vector<std::thread>();
+      new (&tasks)       std::queue<std::function<void()> >();
+      new (&tasks_mutex) std::mutex();
+      new (&tasks_cv)    std::condition_variable();
+
+      stop = false;
+    }
+
+
+    static const size_t MINIMAL_CHUNK_SIZE = 256;     //!< minimal number of elements per chunk
+
+  private:
+    /**
+     * Start additional worker threads if needed.
+     *
+     * \param  n_threads        number of threads
+     */
+    void resize(const size_t n_threads)
+    {
+      std::unique_lock<std::mutex> lock(tasks_mutex);
+
+      while (workers.size() < n_threads) {
+	workers.emplace_back(&JThreadPool::run, this);
+      }
+    }
+
+
+    /**
+     * Worker thread loop.
+     */
+    void run()
+    {
+      for ( ; ; ) {
+
+	std::function<void()> task;
+
+	{
+	  std::unique_lock<std::mutex> lock(tasks_mutex);
+
+	  tasks_cv.wait(lock, [this]() { return stop || !tasks.empty(); });
+
+	  if (stop && tasks.empty()) {
+	    return;
+	  }
+
+	  task = std::move(tasks.front());
+
+	  tasks.pop();
+	}
+
+	task();
+      }
+    }
+
+
+    std::vector<std::thread>          workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex                        tasks_mutex;
+    std::condition_variable           tasks_cv;
+    bool                              stop;
+  };
+
+
+  /**
+   * Get thread pool of this module.
+   *
+   * The pool is reset in a child process after fork (e.g.\ <tt>multiprocessing</tt> with the <tt>fork</tt> start method).
+   *
+   * \return                  thread pool
+   */
+  inline JThreadPool& getThreadPool()
+  {
+    static JThreadPool pool;
+    static const int   status = pthread_atfork(NULL, NULL, []() { getThreadPool().resetAfterFork(); });
+
+    (void) status;
+
+    return pool;
+  }
+
+
+  /**
+   * Print line to standard output.
+   *
+   * The line is printed as a whole, also when this function is called concurrently from several threads.
+   *
+   * \param  line             line
+   */
+  inline void printLine(const std::string& line)
+  {
+    static std::mutex mutex;
+
+    std::unique_lock<std::mutex> lock(mutex);
+
+    std::cout << line << std::endl;
+  }
+
+
+  /**
+   * Execute functions for pairs of consecutive elements.
+   *
+   * The first function is called for each element <tt>i</tt> in <tt>[0, n)</tt>.\n
+   * The second function is called for pair <tt>k</tt> as soon as the first function has been completed
+   * for both elements <tt>2 k</tt> and <tt>2 k + 1</tt>,
+   * so that the processing of a pair overlaps with that of the remaining elements.
+   * This method blocks until all functions have been completed.
+   *
+   * \param  n                number of elements
+   * \param  n_threads        number of threads (0 = number of hardware threads)
+   * \param  first            function for element
+   * \param  second           function for pair of elements
+   */
+  inline void executeInPairs(const size_t n,
+			     const size_t n_threads,
+			     const std::function<void(size_t)>& first,
+			     const std::function<void(size_t)>& second)
+  {
+    std::vector< std::atomic<int> > count(n / 2);
+
+    getThreadPool().execute(n, n_threads, [&](const size_t begin, const size_t end) {
+	for (size_t i = begin; i != end; ++i) {
+
+	  first(i);
+
+	  if (i / 2 < count.size() && ++count[i / 2] == 2) {
+	    second(i / 2);
+	  }
+	}
+      }, 1);
+  }
+
+
+  /**
+   * Auxiliary data structure for concurrent loading of PDF files using the thread pool of this module.
+   *
+   * This data structure has the same interface as JPHYSICS::JSerialLoader.
+   */
+  struct JConcurrentLoader {
+    /**
+     * Execute functions for PDF files.
+     *
+     * \param  n                number of PDF files
+     * \param  first            function for PDF file
+     * \param  second           function for pair of PDF files
+     */
+    void execute(const size_t n,
+		 const std::function<void(size_t)>& first,
+		 const std::function<void(size_t)>& second) const
+    {
+      executeInPairs(n, 0, first, second);
+    }
+
+
+    /**
+     * Print line to standard output.
+     *
+     * \param  line             line
+     */
+    void print(const std::string& line) const
+    {
+      printLine(line);
+    }
+  };
+
+
+  /**
+   * Multi-threaded element-wise evaluation of given function for broadcast arrays.\n
+   * The evaluation is made without holding the Python global interpreter lock.
+   * The function should be thread safe.
+   *
+   * \param  function         function
+   * \param  out              output array or None
+   * \param  n_threads        number of threads (0 = number of hardware threads)
+   * \param  args             broadcast arrays
+   * \return                  output array
+   */
+  template<class T, class JFunction_t, class ...Args>
+  inline py::array_t<T> vectorize(const JFunction_t& function, const py::object& out, const size_t n_threads, const JBroadcastArray<Args>& ...args)
+  {
+    const size_t n = getBroadcastSize(args...);
+
+    py::array_t<T> result = getOutputArray<T>(out, n);
+
+    T* p = result.mutable_data();
+
+    {
+      py::gil_scoped_release release;
+
+      getThreadPool().execute(n, n_threads, [&](const size_t begin, const size_t end) {
+	  for (size_t i = begin; i != end; ++i) {
+	    p[i] = function(args[i]...);
+	  }
+	});
+    }
+
+    return result;
+  }
+}
+
+#endif
@@ -10,5 +10,6 @@ from . import constants
 from . import oscprob
 from . import geane
 from . import lang
+from . import tools
 from . import pdf
 from . import npe
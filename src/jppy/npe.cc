@@ -1,29 +1,69 @@
 #include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
 
-#include "JPhysics/JNPE_t.hh"
+#include "JppyNPE.hh"
 
 namespace py = pybind11;
 
 PYBIND11_MODULE(npe, m) {
     m.doc() = "NPE utilities";
-    py::class_<JMuonNPE_t>(m, "JMuonNPE")
+    py::class_<JPHYSICS::JppyMuonNPE>(m, "JMuonNPE")
         .def(py::init<const std::string &>(),
              py::arg("file_descriptor"))
-        .def("calculate", &JMuonNPE_t::calculate,
+        .def("calculate", py::overload_cast<double, double, double, double>(&JPHYSICS::JppyMuonNPE::calculate, py::const_),
              py::arg("E"),
              py::arg("R"),
              py::arg("theta"),
-             py::arg("phi")
+             py::arg("phi"))
+        .def("calculate", py::overload_cast<const UTILS::array_type<double> &,
+                                            const UTILS::array_type<double> &,
+                                            const UTILS::array_type<double> &,
+                                            const UTILS::array_type<double> &,
+                                            const py::object &>(&JPHYSICS::JppyMuonNPE::calculate, py::const_),
+             py::arg("E"),
+             py::arg("R"),
+             py::arg("theta"),
+             py::arg("phi"),
+             py::arg("out") = py::none())
+        .def("calculate_many", &JPHYSICS::JppyMuonNPE::calculateMany,
+             py::arg("E"),
+             py::arg("R"),
+             py::arg("theta"),
+             py::arg("phi"),
+             py::arg("n_threads") = 0,
+             py::arg("out") = py::none())
+        .def("compact", &JPHYSICS::JppyMuonNPE::compact,
+             py::call_guard<py::gil_scoped_release>()
             ),
-    py::class_<JShowerNPE_t>(m, "JShowerNPE")
+    py::class_<JPHYSICS::JppyShowerNPE>(m, "JShowerNPE")
         .def(py::init<const std::string &, int>(),
              py::arg("file_descriptor"),
              py::arg("number_of_points") = 0)
-        .def("calculate", &JShowerNPE_t::calculate,
+        .def("calculate", py::overload_cast<double, double, double, double, double>(&JPHYSICS::JppyShowerNPE::calculate, py::const_),
+             py::arg("E"),
+             py::arg("D"),
+             py::arg("cd"),
+             py::arg("theta"),
+             py::arg("phi"))
+        .def("calculate", py::overload_cast<const UTILS::array_type<double> &,
+                                            const UTILS::array_type<double> &,
+                                            const UTILS::array_type<double> &,
+                                            const UTILS::array_type<double> &,
+                                            const UTILS::array_type<double> &,
+                                            const py::object &>(&JPHYSICS::JppyShowerNPE::calculate, py::const_),
+             py::arg("E"),
+             py::arg("D"),
+             py::arg("cd"),
+             py::arg("theta"),
+             py::arg("phi"),
+             py::arg("out") = py::none())
+        .def("calculate_many", &JPHYSICS::JppyShowerNPE::calculateMany,
              py::arg("E"),
              py::arg("D"),
              py::arg("cd"),
              py::arg("theta"),
-             py::arg("phi")
+             py::arg("phi"),
+             py::arg("n_threads") = 0,
+             py::arg("out") = py::none()
              );
 }
@@ -14,6 +14,7 @@
 #include "JOscProb/JOscProbInterpolator.hh"
 
 #include "JppyOscProbInterpolator.hh"
+#include "JppyOscProbTable.hh"
 
 #include "utils.hh"
 
@@ -343,12 +344,41 @@ PYBIND11_MODULE(oscprob, m) {
     .def_readwrite("out", &JOSCPROB::JOscChannel::out)
     .def_readwrite("Cparity", &JOSCPROB::JOscChannel::Cparity);
 
+  m.def("get_osc_channel_index", static_cast<int (*)(const JOSCPROB::JOscChannel&)>(&JOSCPROB::getOscChannelIndex),
+	py::arg("channel"));
+  m.def("get_osc_channel_index", [](const UTILS::array_type<int>& in, const UTILS::array_type<int>& out, const UTILS::array_type<int>& Cparity) {
+      return UTILS::vectorize<int>(static_cast<int (*)(const int, const int, const int)>(&JOSCPROB::getOscChannelIndex),
+				   py::none(),
+				   1,
+				   UTILS::JBroadcastArray<int>(in),
+				   UTILS::JBroadcastArray<int>(out),
+				   UTILS::JBroadcastArray<int>(Cparity));
+    },
+    py::arg("flavour_in"),
+    py::arg("flavour_out"),
+    py::arg("Cparity"),
+    "Get indices of oscillation channels for PDG identifiers and charge-parities (-1 if invalid).");
+  m.def("get_osc_channels", []() {
+      py::list channels;
+      for (const JOSCPROB::JOscChannel& channel : JOSCPROB::getOscChannel) {
+	channels.append(channel);
+      }
+      return channels;
+    },
+    "Get oscillation channels in the order of the columns of JppyOscProbInterpolator.get_probabilities.");
+
   py::class_<JOSCPROB::JBaselineCalculator>(m, "JBaselineCalculator")
     .def(py::init<const double, const double>(),
 	 py::arg("Lmin"),
 	 py::arg("Lmax"))
     .def("__call__", &JOSCPROB::JBaselineCalculator::operator(),
 	 py::arg("costh"))
+    .def("__call__", [](const JOSCPROB::JBaselineCalculator& calculator, const UTILS::array_type<double>& costh) {
+	py::array_t<double> L(costh.request().shape);
+	calculator.getBaseline(costh.size(), costh.data(), L.mutable_data());
+	return L;
+      },
+      py::arg("costh"))
     .def("__repr__", &UTILS::get_representation<JOSCPROB::JBaselineCalculator>);
     
   py::class_<JOSCPROB::JOscProbInterpolator<>>(m, "JOscProbInterpolator")
@@ -362,6 +392,9 @@ PYBIND11_MODULE(oscprob, m) {
 	 py::arg("file_name"))
     .def("get_table_parameters", &JOSCPROB::JOscProbInterpolator<>::getTableParameters)
     .def("get_baseline_calculator", &JOSCPROB::JOscProbInterpolator<>::getBaselineCalculator)
+    .def("freeze", &JOSCPROB::JOscProbInterpolator<>::freeze,
+	 py::arg("option") = true)
+    .def("is_frozen", &JOSCPROB::JOscProbInterpolator<>::is_frozen)
     .def("__call__", static_cast<double (JOSCPROB::JOscProbInterpolator<>::*)(const JOSCPROB::JOscChannel&,
     									      const double,
     									      const double) const>(&JOSCPROB::JOscProbInterpolator<>::operator()),
@@ -398,6 +431,133 @@ PYBIND11_MODULE(oscprob, m) {
 	 py::arg("parameters"),	 
 	 py::arg("channel"),
 	 py::arg("E"),
-	 py::arg("costh")
+	 py::arg("costh"))
+    .def("set_fast", &JOSCPROB::JppyOscProbInterpolator<>::setFast,
+	 py::arg("values"))
+    .def("evaluate_grid", static_cast<py::array_t<double> (JOSCPROB::JppyOscProbInterpolator<>::*)(const UTILS::array_type<double>&,
+                                                                                                   const UTILS::array_type<double>&,
+                                                                                                   const UTILS::array_type<double>&,
+                                                                                                   const UTILS::array_type<int>&,
+                                                                                                   const size_t) const>(&JOSCPROB::JppyOscProbInterpolator<>::evaluateGrid),
+	 py::arg("parameters"),
+	 py::arg("E"),
+	 py::arg("costh"),
+	 py::arg("channel"),
+	 py::arg("n_threads") = 0)
+    .def("get_probabilities", static_cast<py::array_t<double> (JOSCPROB::JppyOscProbInterpolator<>::*)(const UTILS::array_type<double>&,
+                                                                                                       const UTILS::array_type<double>&) const>(&JOSCPROB::JppyOscProbInterpolator<>::getProbabilities),
+	 py::arg("E"),
+	 py::arg("costh"))
+    .def("get_probabilities", static_cast<py::array_t<double> (JOSCPROB::JppyOscProbInterpolator<>::*)(const JOSCPROB::JOscParameters&,
+                                                                                                       const UTILS::array_type<double>&,
+                                                                                                       const UTILS::array_type<double>&)>(&JOSCPROB::JppyOscProbInterpolator<>::getProbabilities),
+	 py::arg("parameters"),
+	 py::arg("E"),
+	 py::arg("costh"))
+    .def("get_channel_probabilities", &JOSCPROB::JppyOscProbInterpolator<>::getChannelProbabilities,
+	 py::arg("flavour_in"),
+	 py::arg("flavour_out"),
+	 py::arg("Cparity"),
+	 py::arg("E"),
+	 py::arg("costh"),
+	 py::arg("n_threads") = 0,
+	 py::arg("result") = py::none())
+    .def("get_weights", &JOSCPROB::JppyOscProbInterpolator<>::getWeights,
+	 py::arg("flavour"),
+	 py::arg("Cparity"),
+	 py::arg("E"),
+	 py::arg("costh"),
+	 py::arg("flux"),
+	 py::arg("factor"),
+	 py::arg("n_threads") = 0,
+	 py::arg("result") = py::none())
+    .def("get_gradient", &JOSCPROB::JppyOscProbInterpolator<>::getGradient,
+	 py::arg("channel"),
+	 py::arg("E"),
+	 py::arg("costh"),
+	 py::arg("n_threads") = 0)
+    .def("to_shared", &JOSCPROB::JppyOscProbInterpolator<>::toShared,
+	 py::arg("name"),
+	 py::call_guard<py::gil_scoped_release>())
+    .def_static("from_shared", &JOSCPROB::JppyOscProbInterpolator<>::fromShared,
+		py::arg("name")
+		);
+
+  py::class_<JOSCPROB::JppyOscProbTable>(m, "JppyOscProbTable")
+    .def(py::init<const char*>(),
+	 py::arg("file_name"))
+    .def_static("store", static_cast<void (*)(const JOSCPROB::JOscProbInterpolator<>&, const char*)>(&JOSCPROB::JppyOscProbTable::store),
+		py::arg("interpolator"),
+		py::arg("file_name"),
+		py::call_guard<py::gil_scoped_release>())
+    .def_static("unlink", &JOSCPROB::JppyOscProbTable::unlink,
+		py::arg("name"))
+    .def("get_table_parameters", &JOSCPROB::JppyOscProbTable::getTableParameters)
+    .def("get_baseline_calculator", &JOSCPROB::JppyOscProbTable::getBaselineCalculator)
+    .def("set", static_cast<void (JOSCPROB::JppyOscProbTable::*)(JOSCPROB::JOscParameters)>(&JOSCPROB::JppyOscProbTable::set),
+	 py::arg("parameters"))
+    .def("set_fast", &JOSCPROB::JppyOscProbTable::setFast,
+	 py::arg("values"))
+    .def("__call__", static_cast<double (JOSCPROB::JppyOscProbTable::*)(const JOSCPROB::JOscChannel&,
+									 const double,
+									 const double) const>(&JOSCPROB::JppyOscProbTable::operator()),
+	 py::arg("channel"),
+	 py::arg("E"),
+	 py::arg("costh"))
+    .def("__call__", static_cast<double (JOSCPROB::JppyOscProbTable::*)(const JOSCPROB::JOscParameters&,
+									 const JOSCPROB::JOscChannel&,
+									 const double,
+									 const double)>(&JOSCPROB::JppyOscProbTable::operator()),
+	 py::arg("parameters"),
+	 py::arg("channel"),
+	 py::arg("E"),
+	 py::arg("costh"))
+    .def("__call__", static_cast<py::array_t<double> (JOSCPROB::JppyOscProbTable::*)(const JOSCPROB::JOscChannel&,
+										      const UTILS::array_type<double>&,
+										      const UTILS::array_type<double>&,
+										      const size_t) const>(&JOSCPROB::JppyOscProbTable::operator()),
+	 py::arg("channel"),
+	 py::arg("E"),
+	 py::arg("costh"),
+	 py::arg("n_threads") = 0)
+    .def("__call__", static_cast<py::array_t<double> (JOSCPROB::JppyOscProbTable::*)(const JOSCPROB::JOscParameters&,
+										      const JOSCPROB::JOscChannel&,
+										      const UTILS::array_type<double>&,
+										      const UTILS::array_type<double>&,
+										      const size_t)>(&JOSCPROB::JppyOscProbTable::operator()),
+	 py::arg("parameters"),
+	 py::arg("channel"),
+	 py::arg("E"),
+	 py::arg("costh"),
+	 py::arg("n_threads") = 0)
+    .def("get_channel_probabilities", &JOSCPROB::JppyOscProbTable::getChannelProbabilities,
+	 py::arg("flavour_in"),
+	 py::arg("flavour_out"),
+	 py::arg("Cparity"),
+	 py::arg("E"),
+	 py::arg("costh"),
+	 py::arg("n_threads") = 0,
+	 py::arg("result") = py::none())
+    .def("get_weights", &JOSCPROB::JppyOscProbTable::getWeights,
+	 py::arg("flavour"),
+	 py::arg("Cparity"),
+	 py::arg("E"),
+	 py::arg("costh"),
+	 py::arg("flux"),
+	 py::arg("factor"),
+	 py::arg("n_threads") = 0,
+	 py::arg("result") = py::none())
+    .def("evaluate_grid", &JOSCPROB::JppyOscProbTable::evaluateGrid,
+	 py::arg("parameters"),
+	 py::arg("E"),
+	 py::arg("costh"),
+	 py::arg("channel"),
+	 py::arg("n_threads") = 0)
+    .def("get_probabilities", static_cast<py::array_t<double> (JOSCPROB::JppyOscProbTable::*)(const UTILS::array_type<double>&,
+											       const UTILS::array_type<double>&,
+											       const size_t) const>(&JOSCPROB::JppyOscProbTable::getProbabilities),
+	 py::arg("E"),
+	 py::arg("costh"),
+	 py::arg("n_threads") = 0
 	 );
 }
@@ -1,50 +1,177 @@
 #include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
 
-#include "JPhysics/JPDF_t.hh"
+#include "JppyPDF.hh"
 
 namespace py = pybind11;
 
 PYBIND11_MODULE(pdf, m) {
     m.doc() = "PDF utilities";
-    py::class_<JPDF>(m, "JSinglePDF")
-        .def(py::init<const std::string &, double, int, double>(),
+    PYBIND11_NUMPY_DTYPE(JTOOLS::JResultPDF<double>, f, fp, v, V);
+    py::class_<JPHYSICS::JppySinglePDF>(m, "JSinglePDF")
+        .def(py::init<const std::string &, double, int, double, size_t>(),
              py::arg("file_descriptor"),
              py::arg("TTS"),
              py::arg("number_of_points") = 25,
-             py::arg("epsilon") = 1e-10)
-        .def("calculate", &JPDF::calculate,
+             py::arg("epsilon") = 1e-10,
+             py::arg("n_threads") = 0)
+        .def("calculate", py::overload_cast<double, double, double, double, double>(&JPHYSICS::JppySinglePDF::calculate, py::const_),
              py::arg("E"),
              py::arg("R"),
              py::arg("theta"),
              py::arg("phi"),
-             py::arg("t1")
+             py::arg("t1"))
+        .def("calculate", py::overload_cast<const UTILS::array_type<double> &,
+                                            const UTILS::array_type<double> &,
+                                            const UTILS::array_type<double> &,
+                                            const UTILS::array_type<double> &,
+                                            const UTILS::array_type<double> &,
+                                            const py::object &>(&JPHYSICS::JppySinglePDF::calculate, py::const_),
+             py::arg("E"),
+             py::arg("R"),
+             py::arg("theta"),
+             py::arg("phi"),
+             py::arg("t1"),
+             py::arg("out") = py::none())
+        .def("calculate_many", &JPHYSICS::JppySinglePDF::calculateMany,
+             py::arg("E"),
+             py::arg("R"),
+             py::arg("theta"),
+             py::arg("phi"),
+             py::arg("t1"),
+             py::arg("n_threads") = 0,
+             py::arg("out") = py::none()
             ),
-    py::class_<JMuonPDF_t>(m, "JMuonPDF")
-        .def(py::init<const std::string &, double, int, double>(),
+    py::class_<JPHYSICS::JppyMuonPDF>(m, "JMuonPDF")
+        .def(py::init<const std::string &, double, int, double, const std::string &, size_t>(),
              py::arg("file_descriptor"),
              py::arg("TTS"),
              py::arg("number_of_points") = 25,
-             py::arg("epsilon") = 1e-10)
-        .def("calculate", &JMuonPDF_t::calculate,
+             py::arg("epsilon") = 1e-10,
+             py::arg("cache_dir") = "",
+             py::arg("n_threads") = 0)
+        .def("calculate", py::overload_cast<double, double, double, double, double>(&JPHYSICS::JppyMuonPDF::calculate, py::const_),
+             py::arg("E"),
+             py::arg("R"),
+             py::arg("theta"),
+             py::arg("phi"),
+             py::arg("t1"))
+        .def("calculate", py::overload_cast<const UTILS::array_type<double> &,
+                                            const UTILS::array_type<double> &,
+                                            const UTILS::array_type<double> &,
+                                            const UTILS::array_type<double> &,
+                                            const UTILS::array_type<double> &,
+                                            const py::object &>(&JPHYSICS::JppyMuonPDF::calculate, py::const_),
              py::arg("E"),
              py::arg("R"),
              py::arg("theta"),
              py::arg("phi"),
-             py::arg("t1")
+             py::arg("t1"),
+             py::arg("out") = py::none())
+        .def("calculate_many", &JPHYSICS::JppyMuonPDF::calculateMany,
+             py::arg("E"),
+             py::arg("R"),
+             py::arg("theta"),
+             py::arg("phi"),
+             py::arg("t1"),
+             py::arg("n_threads") = 0,
+             py::arg("out") = py::none()
+            )
+        .def("evaluate", py::overload_cast<double, double, double, double, double, double, double>(&JPHYSICS::JppyMuonPDF::evaluate, py::const_),
+             py::arg("E"),
+             py::arg("t0"),
+             py::arg("D"),
+             py::arg("cd"),
+             py::arg("theta"),
+             py::arg("phi"),
+             py::arg("t_obs"))
+        .def("evaluate", py::overload_cast<double,
+                                           double,
+                                           const UTILS::array_type<double> &,
+                                           const UTILS::array_type<double> &,
+                                           const UTILS::array_type<double> &,
+                                           const UTILS::array_type<double> &,
+                                           const UTILS::array_type<double> &,
+                                           const py::object &>(&JPHYSICS::JppyMuonPDF::evaluate, py::const_),
+             py::arg("E"),
+             py::arg("t0"),
+             py::arg("D"),
+             py::arg("cd"),
+             py::arg("theta"),
+             py::arg("phi"),
+             py::arg("t_obs"),
+             py::arg("out") = py::none())
+        .def("resample", &JPHYSICS::JppyMuonPDF::resample,
+             py::arg("number_of_points") = std::vector<size_t>(),
+             py::arg("precision") = 0.0,
+             py::call_guard<py::gil_scoped_release>())
+        .def("compact", &JPHYSICS::JppyMuonPDF::compact,
+             py::call_guard<py::gil_scoped_release>()
             ),
-    py::class_<JShowerPDF_t>(m, "JShowerPDF")
-        .def(py::init<const std::string &, double, int, double>(),
+    py::class_<JPHYSICS::JppyShowerPDF>(m, "JShowerPDF")
+        .def(py::init<const std::string &, double, int, double, const std::string &, size_t>(),
              py::arg("file_descriptor"),
              py::arg("TTS"),
              py::arg("number_of_points") = 25,
-             py::arg("epsilon") = 1e-10)
-        .def("calculate", &JShowerPDF_t::calculate,
+             py::arg("epsilon") = 1e-10,
+             py::arg("cache_dir") = "",
+             py::arg("n_threads") = 0)
+        .def("calculate", py::overload_cast<double, double, double, double, double, double>(&JPHYSICS::JppyShowerPDF::calculate, py::const_),
+             py::arg("E"),
+             py::arg("D"),
+             py::arg("cd"),
+             py::arg("theta"),
+             py::arg("phi"),
+             py::arg("t1"))
+        .def("calculate", py::overload_cast<const UTILS::array_type<double> &,
+                                            const UTILS::array_type<double> &,
+                                            const UTILS::array_type<double> &,
+                                            const UTILS::array_type<double> &,
+                                            const UTILS::array_type<double> &,
+                                            const UTILS::array_type<double> &,
+                                            const py::object &>(&JPHYSICS::JppyShowerPDF::calculate, py::const_),
+             py::arg("E"),
+             py::arg("D"),
+             py::arg("cd"),
+             py::arg("theta"),
+             py::arg("phi"),
+             py::arg("t1"),
+             py::arg("out") = py::none())
+        .def("calculate_many", &JPHYSICS::JppyShowerPDF::calculateMany,
+             py::arg("E"),
+             py::arg("D"),
+             py::arg("cd"),
+             py::arg("theta"),
+             py::arg("phi"),
+             py::arg("t1"),
+             py::arg("n_threads") = 0,
+             py::arg("out") = py::none()
+            )
+        .def("evaluate", py::overload_cast<double, double, double, double, double, double, double>(&JPHYSICS::JppyShowerPDF::evaluate, py::const_),
+             py::arg("E"),
+             py::arg("t0"),
+             py::arg("D"),
+             py::arg("cd"),
+             py::arg("theta"),
+             py::arg("phi"),
+             py::arg("t_obs"))
+        .def("evaluate", py::overload_cast<double,
+                                           double,
+                                           const UTILS::array_type<double> &,
+                                           const UTILS::array_type<double> &,
+                                           const UTILS::array_type<double> &,
+                                           const UTILS::array_type<double> &,
+                                           const UTILS::array_type<double> &,
+                                           const py::object &>(&JPHYSICS::JppyShowerPDF::evaluate, py::const_),
              py::arg("E"),
+             py::arg("t0"),
              py::arg("D"),
              py::arg("cd"),
              py::arg("theta"),
              py::arg("phi"),
-             py::arg("t1")
+             py::arg("t_obs"),
+             py::arg("out") = py::none()
             ),
     py::class_<JTOOLS::JResultPDF<double>>(m, "JResultPDF")
         .def(py::init<double, double, double, double>(),
@@ -6,12 +6,8 @@ The wrapper classes provide a common interface to evaluate the muon and shower P
 on an event-by-event basis.
 """
 
-from math import sqrt
-
 from abc import ABCMeta, abstractmethod
 
-from jppy import constants as const
-from jppy.geane import JGeaneWater as JGeaneWater
 from jppy.pdf import (
     JMuonPDF as JMuonPDF,
     JShowerPDF as JShowerPDF,
@@ -57,7 +53,7 @@ class PDF(object, metaclass=ABCMeta):
 class MuonPDF(PDF):
     """Muon PDF evaluator"""
 
-    def __init__(self, PDFS, energy=0.0, t0=0.0, TTS=0.0):
+    def __init__(self, PDFS, energy=0.0, t0=0.0, TTS=0.0, cache_dir=""):
         """
         Constructor.
         
@@ -73,12 +69,14 @@ class MuonPDF(PDF):
              or the vertex corresponding to the can interception for atmospheric muons)
         TTS : float
             transit time spread [ns]
+        cache_dir : str
+            directory of the cache of blurred PDFs
+            (default: environment variable ``JPPY_CACHE_DIR``, no caching if unset)
         """
 
         super().__init__(energy, t0)
         
-        self._geane = JGeaneWater()
-        self._pdf = JMuonPDF(PDFS, TTS=TTS)
+        self._pdf = JMuonPDF(PDFS, TTS=TTS, cache_dir=cache_dir)
 
     def evaluate(self, D, cd, theta, phi, t_obs):
         """
@@ -101,24 +99,18 @@ class MuonPDF(PDF):
 
         Returns
         -------
-        muon pdf values : array[float], shape=(n,)
+        muon pdf values : array[JResultPDF], shape=(n,)
+            structured array with the fields ``f``, ``fp``, ``v`` and ``V``\n
+            (a single ``JResultPDF`` if all inputs are scalars)
         """
-        
-        dz = D * cd
-        R = sqrt((D + dz) * (D - dz))
 
-        E = self._geane.get_E(self.energy, dz)
-        
-        t_exp = self.t0 + (dz + R * const.get_kappa_c()) * const.get_inverse_speed_of_light()
-        dt = t_obs - t_exp
-        
-        return self._pdf.calculate(E, R, theta, phi, dt)
+        return self._pdf.evaluate(self.energy, self.t0, D, cd, theta, phi, t_obs)
     
 
 class ShowerPDF(PDF):
     """Shower PDF evaluator"""
 
-    def __init__(self, PDFS, energy=0.0, t0=0.0, TTS=0.0):
+    def __init__(self, PDFS, energy=0.0, t0=0.0, TTS=0.0, cache_dir=""):
         """
         Constructor.
         
@@ -130,11 +122,14 @@ class ShowerPDF(PDF):
             time corresponding to shower vertex [ns]
         TTS : float
             transit time spread [ns]
+        cache_dir : str
+            directory of the cache of blurred PDFs
+            (default: environment variable ``JPPY_CACHE_DIR``, no caching if unset)
         """
 
         super().__init__(energy, t0)
         
-        self._pdf = JShowerPDF(PDFS, TTS=TTS)
+        self._pdf = JShowerPDF(PDFS, TTS=TTS, cache_dir=cache_dir)
 
     def evaluate(self, D, cd, theta, phi, t_obs):
         """
@@ -155,10 +150,9 @@ class ShowerPDF(PDF):
 
         Returns
         -------
-        shower pdf values : array[float], shape=(n,)
+        shower pdf values : array[JResultPDF], shape=(n,)
+            structured array with the fields ``f``, ``fp``, ``v`` and ``V``\n
+            (a single ``JResultPDF`` if all inputs are scalars)
         """
-        
-        t_exp = self.t0 + D * const.get_inverse_speed_of_light() * const.get_index_of_refraction()
-        dt = t_obs - t_exp
-        
-        return self._pdf.calculate(self.energy, D, cd, theta, phi, dt)
+
+        return self._pdf.evaluate(self.energy, self.t0, D, cd, theta, phi, t_obs)
@@ -0,0 +1,90 @@
+#include <string>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+#include "JTools/JFunction1D_t.hh"
+#include "JTools/JFunctionalMap_t.hh"
+#include "JTools/JMultiFunction.hh"
+#include "JTools/JMapList.hh"
+
+#include "utils.hh"
+
+namespace py = pybind11;
+
+namespace {
+
+  /**
+   * Type definition of two-dimensional spline interpolation.
+   */
+  typedef JTOOLS::JMultiFunction<JTOOLS::JSplineFunction1D_t,
+				 JTOOLS::JMAPLIST<JTOOLS::JSplineFunctionalMap>::maplist>   JSplineFunction2D_t;
+
+
+  template<class JFunction1D_t>
+  void declare_function1d(py::module &m, const std::string& class_name) {
+
+    using namespace JPP;
+
+    py::class_<JFunction1D_t>(m, class_name.c_str())
+      .def(py::init<>())
+      .def("put", [](JFunction1D_t& function, const double x, const double y) { function.put(x, y); },
+	   py::arg("x"),
+	   py::arg("y"))
+      .def("compile", [](JFunction1D_t& function) { function.compile(); })
+      .def("__len__", [](const JFunction1D_t& function) { return function.size(); })
+      .def("__call__", [](const JFunction1D_t& function, const double x) { return function(x); },
+	   py::arg("x"))
+      .def("__call__", [](const JFunction1D_t& function, const double x, JCursor& cursor) { return function(x, cursor); },
+	   py::arg("x"),
+	   py::arg("cursor"))
+      .def("__call__", [](const JFunction1D_t& function, const UTILS::array_type<double>& x) {
+
+	  JCursor cursor;
+
+	  return UTILS::vectorize<double>([&function, &cursor](const double x) { return function(x, cursor); },
+					  py::none(),
+					  UTILS::JBroadcastArray<double>(x));
+	},
+	py::arg("x"),
+	"Evaluate function for array of abscissa values; the search of an abscissa value starts at the position of the previous one.");
+  }
+}
+
+
+PYBIND11_MODULE(tools, m) {
+
+  m.doc() = "Interpolation auxiliary classes specific to Jpp";
+
+  py::class_<JTOOLS::JCursor>(m, "JCursor")
+    .def(py::init<>())
+    .def_readwrite("index", &JTOOLS::JCursor::index);
+
+  declare_function1d<JTOOLS::JSplineFunction1D_t>     (m, "JSplineFunction1D");
+  declare_function1d<JTOOLS::JGridSplineFunction1D_t> (m, "JGridSplineFunction1D");
+  declare_function1d<JTOOLS::JPolint1Function1D_t>    (m, "JPolint1Function1D");
+  declare_function1d<JTOOLS::JPolint2Function1D_t>    (m, "JPolint2Function1D");
+  declare_function1d<JTOOLS::JPolint3Function1D_t>    (m, "JPolint3Function1D");
+  declare_function1d<JTOOLS::JGridPolint1Function1D_t>(m, "JGridPolint1Function1D");
+  declare_function1d<JTOOLS::JGridPolint2Function1D_t>(m, "JGridPolint2Function1D");
+  declare_function1d<JTOOLS::JGridPolint3Function1D_t>(m, "JGridPolint3Function1D");
+
+  py::class_<JSplineFunction2D_t>(m, "JSplineFunction2D")
+    .def(py::init<>())
+    .def("put", [](JSplineFunction2D_t& function, const double x, const double y, const double z) { function[x][y] = z; },
+	 py::arg("x"),
+	 py::arg("y"),
+	 py::arg("z"))
+    .def("compile", [](JSplineFunction2D_t& function) { function.compile(); })
+    .def("__call__", [](const JSplineFunction2D_t& function, const double x, const double y) { return function(x, y); },
+	 py::arg("x"),
+	 py::arg("y"))
+    .def("__call__", [](const JSplineFunction2D_t& function, const UTILS::array_type<double>& x, const UTILS::array_type<double>& y) {
+	return UTILS::vectorize<double>([&function](const double x, const double y) { return function(x, y); },
+					py::none(),
+					UTILS::JBroadcastArray<double>(x),
+					UTILS::JBroadcastArray<double>(y));
+      },
+      py::arg("x"),
+      py::arg("y"));
+}
@@ -5,8 +5,18 @@
 #include <sstream>
 #include <string>
 
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+#include "JLang/JException.hh"
+
 namespace UTILS {
 
+  namespace py = pybind11;
+
+  using JLANG::JValueOutOfRange;
+
+
   /**
    * Auxiliary function for defining the representation of a class object.\n
    * The stream output operator must be defined for the given class.
@@ -20,9 +30,184 @@ namespace UTILS {
 
     stringstream stream;
     stream << object;
-    
+
     return stream.str();
   }
+
+
+  /**
+   * Type definition of a contiguous input array.\n
+   * Input which is not contiguous or not of the given data type is converted on the fly.
+   */
+  template<class T>
+  using array_type = py::array_t<T, py::array::c_style | py::array::forcecast>;
+
+
+  /**
+   * Auxiliary data structure for element-wise access of a one-dimensional input array.\n
+   * An input array with a single element (e.g.\ a scalar) is broadcast to any index.
+   */
+  template<class T>
+  class JBroadcastArray {
+  public:
+    /**
+     * Constructor.
+     *
+     * \param  array            input array
+     */
+    JBroadcastArray(const array_type<T>& array) :
+      array(array)
+    {
+      const py::buffer_info buffer = array.request();
+
+      if (buffer.ndim > 1) {
+	THROW(JValueOutOfRange, "JBroadcastArray<T>::JBroadcastArray(): Input array is not one-dimensional.");
+      }
+
+      ptr  = static_cast<const T*>(buffer.ptr);
+      size = buffer.size;
+      step = (size == 1 ? 0 : 1);
+    }
+
+
+    /**
+     * Get number of elements.
+     *
+     * \return                  number of elements
+     */
+    size_t getSize() const
+    {
+      return size;
+    }
+
+
+    /**
+     * Check if this array is broadcast.
+     *
+     * \return                  true if single element; else false
+     */
+    bool is_scalar() const
+    {
+      return size == 1;
+    }
+
+
+    /**
+     * Get element.
+     *
+     * \param  index            index
+     * \return                  value
+     */
+    const T& operator[](const size_t index) const
+    {
+      return ptr[index * step];
+    }
+
+  private:
+    array_type<T> array;
+    const T*      ptr;
+    size_t        size;
+    size_t        step;
+  };
+
+
+  /**
+   * Get common number of elements of broadcast arrays.
+   *
+   * \param  array            broadcast array
+   * \return                  number of elements
+   */
+  template<class T>
+  inline size_t getBroadcastSize(const JBroadcastArray<T>& array)
+  {
+    return array.getSize();
+  }
+
+
+  /**
+   * Get common number of elements of broadcast arrays.
+   *
+   * \param  array            broadcast array
+   * \param  args             remaining broadcast arrays
+   * \return                  number of elements
+   */
+  template<class T, class ...Args>
+  inline size_t getBroadcastSize(const JBroadcastArray<T>& array, const Args& ...args)
+  {
+    const size_t n = getBroadcastSize(args...);
+
+    if (array.is_scalar()) {
+      return n;
+    } else if (n == 1 || n == array.getSize()) {
+      return array.getSize();
+    }
+
+    THROW(JValueOutOfRange, "getBroadcastSize(): Different input array shapes (" << array.getSize() << ", " << n << ")");
+  }
+
+
+  /**
+   * Get output array.\n
+   * If no output array is given, a new array is allocated;
+   * else the given array should be contiguous, writable and have the requested data type and number of elements.
+   *
+   * \param  out              output array or None
+   * \param  n                number of elements
+   * \return                  output array
+   */
+  template<class T>
+  inline py::array_t<T> getOutputArray(const py::object& out, const size_t n)
+  {
+    if (out.is_none()) {
+      return py::array_t<T>(n);
+    }
+
+    if (!py::array_t<T, py::array::c_style>::check_(out)) {
+      THROW(JValueOutOfRange, "getOutputArray(): Output array is not contiguous or has wrong data type.");
+    }
+
+    py::array_t<T> result = py::reinterpret_borrow<py::array_t<T> >(out);
+
+    if (!result.writeable()) {
+      THROW(JValueOutOfRange, "getOutputArray(): Output array is read-only.");
+    }
+
+    if ((size_t) result.size() != n) {
+      THROW(JValueOutOfRange, "getOutputArray(): Output array has wrong size " << result.size() << " != " << n);
+    }
+
+    return result;
+  }
+
+
+  /**
+   * Element-wise evaluation of given function for broadcast arrays.\n
+   * The evaluation is made without holding the Python global interpreter lock.
+   *
+   * \param  function         function
+   * \param  out              output array or None
+   * \param  args             broadcast arrays
+   * \return                  output array
+   */
+  template<class T, class JFunction_t, class ...Args>
+  inline py::array_t<T> vectorize(const JFunction_t& function, const py::object& out, const JBroadcastArray<Args>& ...args)
+  {
+    const size_t n = getBroadcastSize(args...);
+
+    py::array_t<T> result = getOutputArray<T>(out, n);
+
+    T* p = result.mutable_data();
+
+    {
+      py::gil_scoped_release release;
+
+      for (size_t i = 0; i != n; ++i) {
+	p[i] = function(args[i]...);
+      }
+    }
+
+    return result;
+  }
 }
 
 #endif
@@ -1,6 +1,51 @@
+import os
+import struct
+import tempfile
 import unittest
+import numpy as np
 import jppy
 
+
+def write_oscprob_table(file_name):
+    """Write a synthetic oscillation probability table in the binary format of JOscProbInterpolator.
+
+    The table has nodes in the oscillation parameters (dM21sq, dM31sq, deltaCP, sinsqTh12,
+    sinsqTh13, sinsqTh23), L/E and cosine zenith angle; the probabilities of the 18 oscillation
+    channels are smooth functions of the node values.
+    """
+    axes = [[7.0e-5, 7.5e-5, 8.0e-5],
+            [2.4e-3, 2.5e-3, 2.6e-3],
+            [0.0, 2.5, 5.0],
+            [0.28, 0.33],
+            [0.020, 0.025],
+            [0.40, 0.50, 0.60],
+            list(np.geomspace(1e-3, 1e5, 24)),
+            list(np.linspace(-1.0, 1.0, 6))]
+
+    channels = np.arange(18)
+
+    with open(file_name, "wb") as output:
+        # undefined oscillation parameters and baseline extrema
+        output.write(struct.pack("=?d", False, 0.0) * 6)
+        output.write(struct.pack("=dd", 1.0, 12742.0))
+
+        def write(level, point):
+            output.write(struct.pack("=i", len(axes[level])))
+
+            for x in axes[level]:
+                output.write(struct.pack("=d", x))
+
+                if level + 1 != len(axes):
+                    write(level + 1, point + [x])
+                else:
+                    a, b, c, d, e, h, LE, ct = point + [x]
+                    y = 0.5 + 0.4 * np.sin(0.3 * channels + 1e4 * a + 300 * b + 0.7 * c + 3 * d + 20 * e + 2 * h +
+                                           0.5 * np.log(LE) * (1 + 0.1 * channels) + 0.5 * ct)
+                    output.write(y.astype("=f8").tobytes())
+
+        write(0, [])
+
+
 class TestOscParameters(unittest.TestCase):
     def test_oscparameters(self):
         parameters1 = jppy.oscprob.JOscParameters("sinsqTh12", 0.304,
@@ -74,5 +119,310 @@ class TestOscChannel(unittest.TestCase):
         assert(jppy.oscprob.get_charge_parity(+12) == jppy.oscprob.JChargeParity_t.PARTICLE)
         assert(jppy.oscprob.get_charge_parity(+14) == jppy.oscprob.JChargeParity_t.PARTICLE)
         assert(jppy.oscprob.get_charge_parity(+16) == jppy.oscprob.JChargeParity_t.PARTICLE)        
+
+        # Test channel indices
+        channels = jppy.oscprob.get_osc_channels()
+
+        for i, channel in enumerate(channels):
+            assert(jppy.oscprob.get_osc_channel_index(channel) == i)
+
+        indices = jppy.oscprob.get_osc_channel_index(np.array([14, -14, 12, 14]),
+                                                     np.array([14, -16, 14,  0]),
+                                                     np.array([ 1,  -1,  1,  1]))
+
+        assert(list(indices) == [channels.index(jppy.oscprob.JOscChannel(14, 14,  1)),
+                                 channels.index(jppy.oscprob.JOscChannel(14, 16, -1)),
+                                 channels.index(jppy.oscprob.JOscChannel(12, 14,  1)),
+                                 -1])
+
+        # Test invalid enumeration values
+        with self.assertRaises(Exception):
+            jppy.oscprob.get_osc_channel_index(jppy.oscprob.JOscChannel(jppy.oscprob.JFlavour_t(13),
+                                                                        jppy.oscprob.JFlavour_t.MUON,
+                                                                        jppy.oscprob.JChargeParity_t.PARTICLE))
         
                                             
+
+class TestBaselineCalculator(unittest.TestCase):
+    def test_baselinecalculator(self):
+        calculator1 = jppy.oscprob.JBaselineCalculator(1.0, 12742.0)
+        calculator2 = jppy.oscprob.JBaselineCalculator(0.5, 12742.5)
+
+        # Each instance uses its own radii
+        assert(calculator1(1.0)  == 1.0)
+        assert(calculator2(1.0)  == 0.5)
+        assert(calculator1(-1.0) == 12742.0)
+        assert(calculator2(-1.0) == 12742.5)
+
+        costh = np.linspace(-1.0, 1.0, 11)
+
+        L = calculator1(costh)
+
+        assert(L.shape == costh.shape)
+        assert(np.all(L == [calculator1(ct) for ct in costh]))
+
+
+class TestOscProbInterpolator(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls):
+        cls.directory = tempfile.TemporaryDirectory()
+        cls.file_name = os.path.join(cls.directory.name, "JOscProbTable.dat")
+
+        write_oscprob_table(cls.file_name)
+
+    @classmethod
+    def tearDownClass(cls):
+        cls.directory.cleanup()
+
+    def setUp(self):
+        self.interpolator = jppy.oscprob.JppyOscProbInterpolator(self.file_name)
+
+        # dM21sq, dM31sq, deltaCP, sinsqTh12, sinsqTh13, sinsqTh23
+        self.values     = np.array([[7.42e-5, 2.510e-3, 1.278, 0.304, 0.02246, 0.450],
+                                    [7.42e-5, 2.510e-3, 4.000, 0.304, 0.02246, 0.450]])
+        self.parameters = [jppy.oscprob.JOscParameters(*values) for values in self.values]
+
+        self.channel = jppy.oscprob.JOscChannel(14, 14, 1)
+        self.E       = np.geomspace(1.0, 100.0, 50)
+        self.costh   = np.linspace(-1.0, 0.0, 50)
+
+    def test_oscprobinterpolator_freeze(self):
+        interpolator = self.interpolator
+
+        assert(not interpolator.is_frozen())
+
+        expected = [interpolator(parameters, self.channel, self.E, self.costh) for parameters in self.parameters]
+
+        interpolator.freeze()
+
+        assert(interpolator.is_frozen())
+
+        # Values of the frozen table are updated for each set of oscillation parameters
+        for i in (0, 1, 0):
+            assert(np.allclose(interpolator(self.parameters[i], self.channel, self.E, self.costh), expected[i], rtol=0.0, atol=1e-12))
+
+        interpolator.freeze(False)
+
+        assert(not interpolator.is_frozen())
+        assert(np.all(interpolator(self.parameters[1], self.channel, self.E, self.costh) == expected[1]))
+
+    def test_oscprobinterpolator_get_probabilities(self):
+        interpolator = self.interpolator
+
+        channels = jppy.oscprob.get_osc_channels()
+
+        probabilities = interpolator.get_probabilities(self.parameters[0], self.E, self.costh)
+
+        assert(probabilities.shape == (len(self.E), len(channels)))
+
+        # Columns are ordered as the oscillation channels of get_osc_channels
+        for i, channel in enumerate(channels):
+            assert(jppy.oscprob.get_osc_channel_index(channel) == i)
+            assert(np.all(probabilities[:, i] == interpolator(channel, self.E, self.costh)))
+
+        # Non-contiguous and integer input arrays
+        E     = np.repeat(self.E, 2)[::2]
+        costh = np.stack([self.costh, -self.costh], axis=1)[:, 0]
+
+        assert(not E.flags.c_contiguous and not costh.flags.c_contiguous)
+        assert(np.all(interpolator.get_probabilities(E, costh) == probabilities))
+
+        E = np.arange(1, 11)
+
+        assert(np.all(interpolator.get_probabilities(E, self.costh[:10]) ==
+                      interpolator.get_probabilities(E.astype(float), self.costh[:10])))
+
+        with self.assertRaises(Exception):
+            interpolator.get_probabilities(self.E, self.costh[:-1])
+
+    def test_oscprobinterpolator_set_fast(self):
+        interpolator = self.interpolator
+
+        for frozen in (False, True):
+            interpolator.freeze(frozen)
+
+            for values, parameters in zip(self.values, self.parameters):
+                expected = interpolator.get_probabilities(parameters, self.E, self.costh)
+
+                interpolator.set_fast(values)
+
+                assert(np.all(interpolator.get_probabilities(self.E, self.costh) == expected))
+
+        with self.assertRaises(Exception):
+            interpolator.set_fast(self.values[0][:5])
+
+    def test_oscprobinterpolator_get_gradient(self):
+        interpolator = self.interpolator
+
+        values = self.values[0]
+
+        interpolator.set_fast(values)
+
+        probabilities, gradient = interpolator.get_gradient(self.channel, self.E, self.costh)
+
+        assert(gradient.shape == (len(self.E), len(values)))
+        assert(np.allclose(probabilities, interpolator(self.channel, self.E, self.costh), rtol=0.0, atol=1e-12))
+
+        # Oscillation parameter values are linearly interpolated, so that the derivatives
+        # correspond to the forward or backward finite difference (for values at a node)
+        for i, x in enumerate(values):
+            h = 1e-6 * x
+
+            differences = []
+
+            for sign in (+1, -1):
+                shifted    = values.copy()
+                shifted[i] = x + sign * h
+
+                interpolator.set_fast(shifted)
+
+                differences.append(sign * (interpolator(self.channel, self.E, self.costh) - probabilities) / h)
+
+            assert(any(np.allclose(gradient[:, i] * x, difference * x, rtol=0.0, atol=1e-6) for difference in differences))
+
+        with self.assertRaises(Exception):
+            interpolator.get_gradient(self.channel, self.E, self.costh[:-1])
+
+    def test_oscprobinterpolator_get_weights(self):
+        interpolator = self.interpolator
+
+        interpolator.set_fast(self.values[0])
+
+        n       = len(self.E)
+        flavour = np.array([12, 14, 16])[np.arange(n) % 3]
+        Cparity = np.where(np.arange(n) % 4 == 0, -1, 1)
+        flux    = np.random.default_rng(1).uniform(0.5, 2.0, (n, 3))
+        factor  = np.linspace(1.0, 2.0, n)
+
+        # Reference: sum over incoming flavours of flux times probability, times factor
+        probabilities = interpolator.get_probabilities(self.E, self.costh)
+
+        def get_expected(flux, factor):
+            expected = np.zeros(n)
+
+            for j, flavour_in in enumerate((12, 14, 16)):
+                index = jppy.oscprob.get_osc_channel_index(flavour_in, flavour, Cparity)
+
+                expected += flux[:, j] * probabilities[np.arange(n), index]
+
+            return factor * expected
+
+        weights = interpolator.get_weights(flavour, Cparity, self.E, self.costh, flux, factor)
+
+        assert(weights.shape == (n,))
+        assert(np.allclose(weights, get_expected(flux, factor), rtol=1e-12, atol=0.0))
+
+        # Fluxes of shape (1, 3) and scalar factors are broadcast to all events
+        weights = interpolator.get_weights(flavour, Cparity, self.E, self.costh, flux[:1], 2.0)
+
+        assert(np.allclose(weights, get_expected(np.repeat(flux[:1], n, axis=0), 2.0), rtol=1e-12, atol=0.0))
+
+        # Output array is filled in place
+        result  = np.empty(n)
+        weights = interpolator.get_weights(flavour, Cparity, self.E, self.costh, flux, factor, result=result)
+
+        assert(np.all(result == weights))
+
+        for invalid in (flux[:, :2], flux[:-1], flux[:, 0], flux.T):
+            with self.assertRaises(Exception):
+                interpolator.get_weights(flavour, Cparity, self.E, self.costh, invalid, factor)
+
+        with self.assertRaises(Exception):
+            interpolator.get_weights(flavour, Cparity, self.E, self.costh, flux, factor[:-1])
+
+        with self.assertRaises(Exception):
+            interpolator.get_weights(13, Cparity, self.E, self.costh, flux, factor)
+
+    def test_oscprobinterpolator_evaluate_grid(self):
+        interpolator = self.interpolator
+
+        channels = jppy.oscprob.get_osc_channels()
+        channel  = np.arange(len(self.E)) % len(channels)
+
+        result = interpolator.evaluate_grid(self.values, self.E, self.costh, channel)
+
+        assert(result.shape == (len(self.values), len(self.E)))
+
+        for parameters, probabilities in zip(self.parameters, result):
+            for i, osc_channel in enumerate(channels):
+                mask     = (channel == i)
+                expected = interpolator(parameters, osc_channel, self.E[mask], self.costh[mask])
+
+                assert(np.allclose(probabilities[mask], expected, rtol=0.0, atol=1e-12))
+
+        with self.assertRaises(Exception):
+            interpolator.evaluate_grid(self.values[:, :5], self.E, self.costh, channel)
+
+    def test_oscprobinterpolator_shared(self):
+        interpolator = self.interpolator
+
+        name = "/jppy_test_oscprob_{}".format(os.getpid())
+
+        interpolator.to_shared(name)
+
+        try:
+            table = jppy.oscprob.JppyOscProbInterpolator.from_shared(name)
+        finally:
+            jppy.oscprob.JppyOscProbTable.unlink(name)
+
+        with self.assertRaises(Exception):
+            jppy.oscprob.JppyOscProbInterpolator.from_shared(name)
+
+        # The table remains available after the shared memory object is unlinked
+        interpolator.set_fast(self.values[0])
+        table       .set_fast(self.values[0])
+
+        n       = len(self.E)
+        channel = np.arange(n) % len(jppy.oscprob.get_osc_channels())
+        flavour = np.where(np.arange(n) % 2 == 0, 12, 14)
+        flux    = np.random.default_rng(1).uniform(0.5, 2.0, (n, 3))
+
+        assert(np.all(table(self.channel, self.E, self.costh) ==
+                      interpolator(self.channel, self.E, self.costh)))
+        assert(np.all(table.get_probabilities(self.E, self.costh) ==
+                      interpolator.get_probabilities(self.E, self.costh)))
+        assert(np.all(table.get_channel_probabilities(14, flavour, 1, self.E, self.costh) ==
+                      interpolator.get_channel_probabilities(14, flavour, 1, self.E, self.costh)))
+        assert(np.all(table.get_weights(flavour, -1, self.E, self.costh, flux, 2.0) ==
+                      interpolator.get_weights(flavour, -1, self.E, self.costh, flux, 2.0)))
+        assert(np.allclose(table.evaluate_grid(self.values, self.E, self.costh, channel),
+                           interpolator.evaluate_grid(self.values, self.E, self.costh, channel), rtol=0.0, atol=1e-12))
+
+    def test_oscprobtable_store(self):
+        interpolator = self.interpolator
+
+        with tempfile.TemporaryDirectory() as directory:
+            file_name = os.path.join(directory, "JOscProbTable.NO.jppy")
+
+            jppy.oscprob.JppyOscProbTable.store(interpolator, file_name)
+
+            table = jppy.oscprob.JppyOscProbTable(file_name)
+
+            # Memory-mapped table reproduces the original table exactly
+            for parameters in self.parameters:
+                assert(np.all(table(parameters, self.channel, self.E, self.costh) ==
+                              interpolator(parameters, self.channel, self.E, self.costh)))
+                assert(np.all(table.get_probabilities(self.E, self.costh) ==
+                              interpolator.get_probabilities(self.E, self.costh)))
+
+            invalid = os.path.join(directory, "invalid.jppy")
+
+            with open(invalid, "wb") as output:
+                output.write(b"\0" * 4096)
+
+            with self.assertRaises(Exception):
+                jppy.oscprob.JppyOscProbTable(invalid)
+
+            # Offsets of the maps of the second dimension (see JppyOscProbTableHeader) out of range
+            with open(file_name, "rb") as input:
+                data = bytearray(input.read())
+
+            offset = struct.unpack_from("=Q", data, 224 + 8)[0]
+
+            struct.pack_into("=Q", data, offset + 8, 1 << 40)
+
+            with open(invalid, "wb") as output:
+                output.write(data)
+
+            with self.assertRaises(Exception):
+                jppy.oscprob.JppyOscProbTable(invalid)
@@ -0,0 +1,68 @@
+import unittest
+import numpy as np
+import jppy
+
+PDFS = "pdfs/J%p.dat"
+
+class TestMuonNPE(unittest.TestCase):
+    def setUp(self):
+        rng = np.random.default_rng(1)
+        self.E = rng.uniform(10, 1000, 1000)
+        self.R = rng.uniform(1, 100, 1000)
+        self.theta = rng.uniform(0, np.pi, 1000)
+        self.phi = rng.uniform(0, np.pi, 1000)
+
+    def test_npe_array(self):
+        muon_npe = jppy.npe.JMuonNPE(PDFS)
+        expected = [muon_npe.calculate(*args) for args in zip(self.E, self.R, self.theta, self.phi)]
+        self.assertTrue(np.any(np.array(expected) > 0))
+        self.assertTrue(np.array_equal(expected, muon_npe.calculate(self.E, self.R, self.theta, self.phi)))
+        # single elements are broadcast
+        expected = [muon_npe.calculate(self.E[0], R, self.theta[0], self.phi[0]) for R in self.R]
+        self.assertTrue(np.array_equal(expected, muon_npe.calculate(self.E[:1], self.R, self.theta[:1], self.phi[:1])))
+
+    def test_npe_calculate_many(self):
+        muon_npe = jppy.npe.JMuonNPE(PDFS)
+        expected = [muon_npe.calculate(*args) for args in zip(self.E, self.R, self.theta, self.phi)]
+        for n_threads in (0, 1, 3):
+            result = muon_npe.calculate_many(self.E, self.R, self.theta, self.phi, n_threads=n_threads)
+            self.assertTrue(np.array_equal(expected, result))
+        out = np.empty(len(self.E))
+        result = muon_npe.calculate_many(self.E, self.R, self.theta, self.phi, n_threads=4, out=out)
+        self.assertIs(out, result)
+        self.assertTrue(np.array_equal(expected, out))
+
+    def test_npe_compact(self):
+        muon_npe = jppy.npe.JMuonNPE(PDFS)
+        # including distances outside the range of the tables
+        R = np.concatenate((self.R, np.geomspace(0.1, 500, 1000)))
+        theta = np.resize(self.theta, len(R))
+        phi = np.resize(self.phi, len(R))
+        E = np.resize(self.E, len(R))
+        expected = muon_npe.calculate(E, R, theta, phi)
+        muon_npe.compact()
+        self.assertTrue(np.array_equal(expected, muon_npe.calculate(E, R, theta, phi)))
+        self.assertTrue(np.array_equal(expected, muon_npe.calculate_many(E, R, theta, phi, n_threads=4)))
+        self.assertEqual(expected[0], muon_npe.calculate(E[0], R[0], theta[0], phi[0]))
+
+class TestShowerNPE(unittest.TestCase):
+    def setUp(self):
+        rng = np.random.default_rng(1)
+        self.E = rng.uniform(10, 1000, 1000)
+        self.D = rng.uniform(1, 100, 1000)
+        self.cd = rng.uniform(-1, 1, 1000)
+        self.theta = rng.uniform(0, np.pi, 1000)
+        self.phi = rng.uniform(0, np.pi, 1000)
+
+    def test_npe_array(self):
+        shower_npe = jppy.npe.JShowerNPE(PDFS)
+        expected = [shower_npe.calculate(*args) for args in zip(self.E, self.D, self.cd, self.theta, self.phi)]
+        self.assertTrue(np.any(np.array(expected) > 0))
+        self.assertTrue(np.array_equal(expected, shower_npe.calculate(self.E, self.D, self.cd, self.theta, self.phi)))
+
+    def test_npe_calculate_many(self):
+        shower_npe = jppy.npe.JShowerNPE(PDFS)
+        expected = [shower_npe.calculate(*args) for args in zip(self.E, self.D, self.cd, self.theta, self.phi)]
+        for n_threads in (0, 1, 3):
+            result = shower_npe.calculate_many(self.E, self.D, self.cd, self.theta, self.phi, n_threads=n_threads)
+            self.assertTrue(np.array_equal(expected, result))
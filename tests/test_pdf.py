@@ -1,4 +1,8 @@
+import os
+import multiprocessing
+import tempfile
 import unittest
+import numpy as np
 import jppy
 
 PDFS = "pdfs/J%p.dat"
@@ -12,6 +16,130 @@ class TestMuonPDF(unittest.TestCase):
         self.assertAlmostEqual(0.01374949305, result.v)
         self.assertAlmostEqual(0.053314508, result.V)
 
+    def test_pdf_array(self):
+        muon_pdf = jppy.pdf.JMuonPDF(PDFS, 0)
+        E = np.array([10, 10, 100])
+        R = np.array([5, 5, 10])
+        result = muon_pdf.calculate(E, R, 0, 0, [23, 23, 6])
+        self.assertEqual(3, len(result))
+        for i, (E_i, R_i, t1_i) in enumerate(zip(E, R, [23, 23, 6])):
+            expected = muon_pdf.calculate(E_i, R_i, 0, 0, t1_i)
+            self.assertAlmostEqual(expected.f, result["f"][i])
+            self.assertAlmostEqual(expected.fp, result["fp"][i])
+            self.assertAlmostEqual(expected.v, result["v"][i])
+            self.assertAlmostEqual(expected.V, result["V"][i])
+        self.assertAlmostEqual(0.00067762789, result["f"][0])
+
+    def test_pdf_array_out(self):
+        muon_pdf = jppy.pdf.JMuonPDF(PDFS, 0)
+        out = muon_pdf.calculate(np.full(4, 10.0), 5, 0, 0, 23)
+        result = muon_pdf.calculate(np.full(4, 100.0), 10, 0, 0, 6, out=out)
+        self.assertIs(out, result)
+        expected = muon_pdf.calculate(100, 10, 0, 0, 6)
+        self.assertTrue(np.allclose(expected.f, out["f"]))
+        with self.assertRaises(Exception):
+            muon_pdf.calculate(np.full(3, 10.0), 5, 0, 0, 23, out=out)
+
+    def test_pdf_calculate_many(self):
+        muon_pdf = jppy.pdf.JMuonPDF(PDFS, 0)
+        E = np.linspace(10, 1000, 10000)
+        R = np.linspace(1, 50, 10000)
+        t1 = np.linspace(-10, 100, 10000)
+        expected = muon_pdf.calculate(E, R, 0.5, 1.0, t1)
+        for n_threads in (1, 4, 0):
+            result = muon_pdf.calculate_many(E, R, 0.5, 1.0, t1, n_threads=n_threads)
+            self.assertTrue(np.array_equal(expected, result))
+
+    @unittest.skipUnless(hasattr(os, "fork"), "requires fork")
+    def test_pdf_calculate_many_fork(self):
+        muon_pdf = jppy.pdf.JMuonPDF(PDFS, 0)
+        E = np.linspace(10, 1000, 10000)
+        expected = muon_pdf.calculate_many(E, 5, 0.5, 1.0, 23, n_threads=4)
+
+        def check():
+            result = muon_pdf.calculate_many(E, 5, 0.5, 1.0, 23, n_threads=4)
+            os._exit(0 if np.array_equal(expected, result) else 1)
+
+        process = multiprocessing.get_context("fork").Process(target=check)
+        process.start()
+        process.join(60)
+        if process.is_alive():
+            process.kill()
+        self.assertEqual(0, process.exitcode)
+
+    def test_pdf_resample(self):
+        muon_pdf = jppy.pdf.JMuonPDF(PDFS, 0)
+        rng = np.random.default_rng(1)
+        R = rng.uniform(1, 50, 10000)
+        theta = rng.uniform(0, np.pi, 10000)
+        phi = rng.uniform(0, np.pi, 10000)
+        t1 = rng.uniform(0, 100, 10000)
+        expected = muon_pdf.calculate(10, R, theta, phi, t1)
+        with self.assertRaises(Exception):
+            muon_pdf.resample([10, 10, 10, 50], precision=1e-12)
+        deviation = muon_pdf.resample([10, 10, 10, 50])
+        # the deviation is evaluated deterministically and is used for the check of the precision
+        with self.assertRaises(Exception):
+            muon_pdf.resample([10, 10, 10, 50], precision=0.5 * deviation)
+        self.assertEqual(deviation, muon_pdf.resample([10, 10, 10, 50], precision=deviation))
+        # a coarser grid yields a larger deviation than the original number of nodes
+        self.assertGreater(deviation, 0)
+        self.assertLess(jppy.pdf.JMuonPDF(PDFS, 0).resample([]), deviation)
+        result = muon_pdf.calculate(10, R, theta, phi, t1)
+        self.assertFalse(np.array_equal(expected["f"], result["f"]))
+        self.assertTrue(np.all(result["f"] >= 0))
+        # the deviation is relative to the maximal values of the individual PDFs, which are added with different weights
+        self.assertLessEqual(np.max(np.abs(result["V"] - expected["V"])), 2 * deviation * np.max(np.abs(expected["V"])))
+        # out of range as the original tables
+        result = muon_pdf.calculate(10, 1e6, 0, 0, 23)
+        self.assertEqual(0, result.f)
+        self.assertEqual(0, result.V)
+        result = muon_pdf.calculate(10, 5, 0, 0, 1e5)
+        self.assertEqual(0, result.f)
+        self.assertAlmostEqual(result.V, result.v)
+
+    def test_pdf_compact(self):
+        muon_pdf = jppy.pdf.JMuonPDF(PDFS, 0)
+        # the compacted table uses a binary search of the (logarithmic) distance axis
+        R = np.concatenate((np.linspace(1, 100, 50), np.geomspace(0.1, 500, 950)))
+        t1 = np.resize(np.linspace(-10, 100, 50), len(R))
+        expected = muon_pdf.calculate(10, R, 0.3, 0.2, t1)
+        muon_pdf.compact()
+        result = muon_pdf.calculate(10, R, 0.3, 0.2, t1)
+        self.assertTrue(np.array_equal(expected, result))
+
+    def test_pdf_cache(self):
+        with tempfile.TemporaryDirectory() as cache_dir:
+            muon_pdf = jppy.pdf.JMuonPDF(PDFS, 2.0, 5, cache_dir=cache_dir)
+            self.assertTrue(os.listdir(cache_dir))
+            cached_pdf = jppy.pdf.JMuonPDF(PDFS, 2.0, 5, cache_dir=cache_dir)
+            R = np.linspace(5, 50, 20)
+            t1 = np.linspace(-10, 100, 20)
+            expected = muon_pdf.calculate(10, R, 0.3, 0.2, t1)
+            result = cached_pdf.calculate(10, R, 0.3, 0.2, t1)
+            self.assertTrue(np.array_equal(expected, result))
+            # other blurring parameters use another cache entry
+            other_pdf = jppy.pdf.JMuonPDF(PDFS, 3.0, 5, cache_dir=cache_dir)
+            self.assertFalse(np.array_equal(expected, other_pdf.calculate(10, R, 0.3, 0.2, t1)))
+
+    def test_pdf_blur(self):
+        # the parallel blurring of the PDFs yields the same result as the serial blurring
+        serial_pdf = jppy.pdf.JMuonPDF(PDFS, 2.0, 5, n_threads=1)
+        parallel_pdf = jppy.pdf.JMuonPDF(PDFS, 2.0, 5, n_threads=4)
+        rng = np.random.default_rng(1)
+        R = rng.uniform(1, 100, 1000)
+        theta = rng.uniform(0, np.pi, 1000)
+        phi = rng.uniform(0, np.pi, 1000)
+        t1 = rng.uniform(-20, 200, 1000)
+        expected = serial_pdf.calculate(10, R, theta, phi, t1)
+        self.assertTrue(np.any(expected["f"] > 0))
+        self.assertTrue(np.array_equal(expected, parallel_pdf.calculate(10, R, theta, phi, t1)))
+
+    def test_pdf_array_shape_mismatch(self):
+        muon_pdf = jppy.pdf.JMuonPDF(PDFS, 0)
+        with self.assertRaises(Exception):
+            muon_pdf.calculate([10, 20], [5, 5, 5], 0, 0, 23)
+
 class TestShowerPDF(unittest.TestCase):
     def test_pdf(self):
         shower_pdf = jppy.pdf.JShowerPDF(PDFS, 0)
@@ -20,3 +148,40 @@ class TestShowerPDF(unittest.TestCase):
         self.assertAlmostEqual(5.1614638414144165e-05, result.fp)
         self.assertAlmostEqual(0.01054815545, result.v)
         self.assertAlmostEqual(0.150554603, result.V)
+
+    def test_pdf_array(self):
+        shower_pdf = jppy.pdf.JShowerPDF(PDFS, 0)
+        result = shower_pdf.calculate([100, 100], 10, 0.1, 0.2, 0.3, 6)
+        self.assertEqual(2, len(result))
+        self.assertAlmostEqual(0.0013937540, result["f"][1])
+        self.assertAlmostEqual(5.1614638414144165e-05, result["fp"][1])
+        self.assertAlmostEqual(0.01054815545, result["v"][1])
+        self.assertAlmostEqual(0.150554603, result["V"][1])
+
+    def test_pdf_blur(self):
+        # the parallel blurring of the PDF yields the same result as the serial blurring
+        serial_pdf = jppy.pdf.JShowerPDF(PDFS, 2.0, 5, n_threads=1)
+        parallel_pdf = jppy.pdf.JShowerPDF(PDFS, 2.0, 5, n_threads=4)
+        rng = np.random.default_rng(1)
+        D = rng.uniform(1, 100, 1000)
+        cd = rng.uniform(-1, 1, 1000)
+        theta = rng.uniform(0, np.pi, 1000)
+        phi = rng.uniform(0, np.pi, 1000)
+        t1 = rng.uniform(-20, 200, 1000)
+        expected = serial_pdf.calculate(100, D, cd, theta, phi, t1)
+        self.assertTrue(np.any(expected["f"] > 0))
+        self.assertTrue(np.array_equal(expected, parallel_pdf.calculate(100, D, cd, theta, phi, t1)))
+
+    def test_pdf_cache(self):
+        with tempfile.TemporaryDirectory() as cache_dir:
+            shower_pdf = jppy.pdf.JShowerPDF(PDFS, 2.0, 5, cache_dir=cache_dir)
+            self.assertTrue(os.listdir(cache_dir))
+            cached_pdf = jppy.pdf.JShowerPDF(PDFS, 2.0, 5, cache_dir=cache_dir)
+            D = np.linspace(5, 50, 20)
+            t1 = np.linspace(-10, 100, 20)
+            expected = shower_pdf.calculate(100, D, 0.1, 0.2, 0.3, t1)
+            result = cached_pdf.calculate(100, D, 0.1, 0.2, 0.3, t1)
+            self.assertTrue(np.array_equal(expected, result))
+            # other blurring parameters use another cache entry
+            other_pdf = jppy.pdf.JShowerPDF(PDFS, 3.0, 5, cache_dir=cache_dir)
+            self.assertFalse(np.array_equal(expected, other_pdf.calculate(100, D, 0.1, 0.2, 0.3, t1)))
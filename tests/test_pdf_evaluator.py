@@ -1,4 +1,5 @@
 import unittest
+import numpy as np
 import jppy
 
 PDFS = "pdfs/J%p.dat"
@@ -13,6 +14,16 @@ class TestMuonPDFEvaluator(unittest.TestCase):
         self.assertAlmostEqual(0.035047945, result.v)
         self.assertAlmostEqual(0.09606971431, result.V)
 
+    def test_pdf_evaluator_array(self):
+        E, t0, t_obs, D, cd, theta, phi = [1e3, 56, 292, 50, 0.7, 1.57, 3.14]
+        muon_pdf = jppy.pdf_evaluator.MuonPDF(PDFS, E, t0)
+        result = muon_pdf.evaluate(np.full(3, D), cd, theta, phi, np.full(3, t_obs))
+        self.assertEqual(3, len(result))
+        self.assertTrue(np.allclose(0.00388579021, result["f"]))
+        self.assertTrue(np.allclose(-0.000739757, result["fp"]))
+        self.assertTrue(np.allclose(0.035047945, result["v"]))
+        self.assertTrue(np.allclose(0.09606971431, result["V"]))
+
 class TestShowerPDFEvaluator(unittest.TestCase):
     def test_pdf_evaluator(self):
         E, t0, t_obs, D, cd, theta, phi = [50, 198, 226, 5, 0.6, 0.5, 0.4]
@@ -22,3 +33,13 @@ class TestShowerPDFEvaluator(unittest.TestCase):
         self.assertAlmostEqual(0.0006429129, result.fp)
         self.assertAlmostEqual(0.01406847423, result.v)
         self.assertAlmostEqual(0.297769976, result.V)
+
+    def test_pdf_evaluator_array(self):
+        E, t0, t_obs, D, cd, theta, phi = [50, 198, 226, 5, 0.6, 0.5, 0.4]
+        shower_pdf = jppy.pdf_evaluator.ShowerPDF(PDFS, E, t0)
+        result = shower_pdf.evaluate(np.full(3, D), cd, theta, phi, np.full(3, t_obs))
+        self.assertEqual(3, len(result))
+        self.assertTrue(np.allclose(0.006247665, result["f"]))
+        self.assertTrue(np.allclose(0.0006429129, result["fp"]))
+        self.assertTrue(np.allclose(0.01406847423, result["v"]))
+        self.assertTrue(np.allclose(0.297769976, result["V"]))
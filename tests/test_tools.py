@@ -0,0 +1,139 @@
+import unittest
+import numpy as np
+import jppy
+
+
+def z(x, y):
+    return np.sin(0.5 * x) * np.cos(y) + 0.1 * x * y
+
+
+def nested_spline(X, splines, x, y):
+    """Spline interpolation of the values of the inner splines at y along the outer axis."""
+    h = jppy.tools.JSplineFunction1D()
+    for X_i, spline in zip(X, splines):
+        h.put(X_i, spline(y))
+    h.compile()
+    return h(x)
+
+
+class TestSplineFunction2D(unittest.TestCase):
+    def test_tensor_product(self):
+        X = 0.1 * np.arange(12)**2 + 0.3 * np.arange(12)
+        Y = -2.0 + 0.25 * np.arange(15) + 0.01 * np.arange(15)**2
+        f = jppy.tools.JSplineFunction2D()
+        splines = []
+        for x in X:
+            spline = jppy.tools.JSplineFunction1D()
+            for y in Y:
+                f.put(x, y, z(x, y))
+                spline.put(y, z(x, y))
+            spline.compile()
+            splines.append(spline)
+        f.compile()
+        # nodes are reproduced exactly
+        for x in X:
+            for y in Y:
+                self.assertEqual(z(x, y), f(x, y))
+        # same result as the nested evaluation to within rounding
+        for x in np.linspace(X[0], X[-1], 41):
+            for y in np.linspace(Y[0], Y[-1], 41):
+                self.assertTrue(np.isclose(nested_spline(X, splines, x, y), f(x, y), rtol=1e-12, atol=1e-12))
+        x = np.linspace(X[0], X[-1], 41)
+        self.assertTrue(np.array_equal([f(x_i, 0.3) for x_i in x], f(x, 0.3)))
+        with self.assertRaises(Exception):
+            f(X[-1] + 1.0, 0.0)
+
+    def test_different_grids(self):
+        # the inner splines are not defined on the same grid, so that the outer spline is compiled at each evaluation
+        X = np.array([0.0, 0.5, 1.5, 2.0, 3.5, 5.0])
+        f = jppy.tools.JSplineFunction2D()
+        splines = []
+        for i, x in enumerate(X):
+            spline = jppy.tools.JSplineFunction1D()
+            for y in -0.1 * i + 0.5 * np.arange(10):
+                f.put(x, y, z(x, y))
+                spline.put(y, z(x, y))
+            spline.compile()
+            splines.append(spline)
+        f.compile()
+        for x in np.linspace(0.0, 5.0, 21):
+            for y in np.linspace(0.0, 4.0, 21):
+                self.assertEqual(nested_spline(X, splines, x, y), f(x, y))
+
+
+class TestSplineFunction1D(unittest.TestCase):
+    def test_spline(self):
+        for f in (jppy.tools.JSplineFunction1D(), jppy.tools.JGridSplineFunction1D()):
+            X = np.linspace(-1.0, 2.0, 13)
+            for x in X:
+                f.put(x, np.exp(x))
+            f.compile()
+            self.assertEqual(13, len(f))
+            for x in X:
+                self.assertEqual(np.exp(x), f(x))
+            x = np.linspace(-1.0, 2.0, 101)
+            self.assertTrue(np.allclose(np.exp(x), f(x), rtol=1e-3))
+
+
+class TestCursor(unittest.TestCase):
+    def test_cursor(self):
+        for f in (jppy.tools.JSplineFunction1D(), jppy.tools.JGridSplineFunction1D()):
+            X = np.linspace(0.0, 10.0, 41)
+            for x in X:
+                f.put(x, np.sin(x))
+            f.compile()
+            rng = np.random.default_rng(1)
+            x = np.concatenate((np.sort(rng.uniform(0.0, 10.0, 500)),
+                                np.sort(rng.uniform(0.0, 10.0, 500))[::-1],
+                                rng.uniform(0.0, 10.0, 500),
+                                X))
+            # the search with a cursor yields the same position as the binary search
+            cursor = jppy.tools.JCursor()
+            for x_i in x:
+                self.assertEqual(f(x_i), f(x_i, cursor))
+            self.assertTrue(np.array_equal([f(x_i) for x_i in x], f(x)))
+            with self.assertRaises(Exception):
+                f(11.0, cursor)
+
+    def test_stale_cursor(self):
+        for f in (jppy.tools.JSplineFunction1D(), jppy.tools.JGridSplineFunction1D()):
+            X = np.linspace(0.0, 10.0, 41)
+            for x in X:
+                f.put(x, np.sin(x))
+            f.compile()
+            cursor = jppy.tools.JCursor()
+            self.assertEqual(f(9.9), f(9.9, cursor))
+            self.assertGreater(cursor.index, 0)
+            # insertion in front of the position held by the cursor
+            for x in -0.25 * np.arange(1, 11):
+                f.put(x, np.sin(x))
+            f.compile()
+            for x in (9.9, 9.9, 0.1, -2.4, 5.0):
+                self.assertEqual(f(x), f(x, cursor))
+            cursor.index = 10**6
+            self.assertEqual(f(5.0), f(5.0, cursor))
+
+
+class TestPolintFunction1D(unittest.TestCase):
+    def test_grid(self):
+        # equidistant points are interpolated with the Lagrange form, other points with Neville's algorithm
+        for N, grid_type, function_type in ((1, jppy.tools.JGridPolint1Function1D, jppy.tools.JPolint1Function1D),
+                                            (2, jppy.tools.JGridPolint2Function1D, jppy.tools.JPolint2Function1D),
+                                            (3, jppy.tools.JGridPolint3Function1D, jppy.tools.JPolint3Function1D)):
+            rng = np.random.default_rng(N)
+            for trial in range(20):
+                X = -5.0 + 0.125 * rng.integers(0, 80) + 0.125 * rng.integers(1, 9) * np.arange(8 + trial)
+                Y = np.sin(1.3 * X) + 0.5 * rng.uniform(size=len(X))
+                g = grid_type()
+                f = function_type()
+                for x, y in zip(X, Y):
+                    g.put(x, y)
+                    f.put(x, y)
+                g.compile()
+                f.compile()
+                # nodes are reproduced exactly
+                self.assertTrue(np.array_equal(Y, g(X)))
+                self.assertTrue(np.array_equal(Y, f(X)))
+                # results are not bit-identical, but agree to within rounding
+                x = np.linspace(X[0], X[-1], 2001)
+                self.assertLess(np.max(np.abs(g(x) - f(x))), 1e-13 * np.max(np.abs(Y)))